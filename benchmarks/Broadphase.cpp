@@ -0,0 +1,87 @@
+#include "Engine.hpp"
+#include "GameState.hpp"
+#include "Physics.hpp"
+#include "Transform.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+/// \brief Cell size large enough to put every Collider in one cell, so every pair is compared like before the broadphase
+const double ONE_CELL = 1.0e9;
+
+/// \brief Result of running one scene
+struct Result
+{
+  /// \brief Average milliseconds per frame
+  double ms;
+  /// \brief Sum of every Object's final position, so runs with different cell sizes can be compared
+  double checksum;
+};
+
+/// \brief Builds a static scene of half AABBColliders and half CircleColliders on a jittered grid and runs it
+/// \param engine Engine to run the scene under
+/// \param count Number of Colliders
+/// \param cellSize Broadphase cell size
+/// \param frames Number of frames to time
+/// \return Time per frame and checksum
+static Result Run(Aspen::Engine::Engine &engine, int count, double cellSize, int frames)
+{
+  Aspen::Physics::Physics *physics = engine.FindChildOfType<Aspen::Physics::Physics>();
+  physics->SetCellSize(cellSize);
+  Aspen::GameState::GameState *state = engine.FindChildOfType<Aspen::GameState::GameStateManager>()->CreateChild<Aspen::GameState::GameState>();
+  std::srand(1);
+  int columns = int(std::sqrt(double(count))) + 1;
+  for (int i = 0; i < count; ++i)
+  {
+    Aspen::Object::Object *o = state->CreateChild<Aspen::Object::Object>();
+    o->CreateTransform()->SetPosition((i % columns) * 40 + std::rand() % 25 + 0.37f, (i / columns) * 40 + std::rand() % 25 + 0.61f);
+    if (i % 2)
+      o->CreateChild<Aspen::Physics::AABBCollider>()->SetSize(20 + std::rand() % 20, 20 + std::rand() % 20);
+    else
+      o->CreateChild<Aspen::Physics::CircleCollider>()->SetRadius(10 + std::rand() % 10);
+  }
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int f = 0; f < frames; ++f)
+    engine();
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+  Result result;
+  result.ms = std::chrono::duration<double, std::milli>(end - start).count() / frames;
+  result.checksum = 0.0;
+  for (Aspen::Object::Object *o : state->Children())
+    result.checksum += o->GetTransform()->GetLocalXPosition() * 3.0 + o->GetTransform()->GetLocalYPosition();
+  state->Parent()->RemoveChild(state);
+  delete state;
+  return result;
+}
+
+/// \brief Times Physics::Step with the default cell size against a single cell holding every Collider
+///        Usage: broadphase [frames] [counts...]
+///        Run with `make benchmark RELEASE=1`
+int main(int argc, char **argv)
+{
+  int frames = argc > 1 ? std::atoi(argv[1]) : 20;
+  std::vector<int> counts;
+  for (int i = 2; i < argc; ++i)
+    counts.push_back(std::atoi(argv[i]));
+  if (counts.empty())
+    counts = {250, 500, 1000, 2000, 4000, 8000};
+
+  Aspen::Log::Info.TogglePrint();
+  Aspen::Engine::Engine engine(Aspen::Engine::START_FLAGS::HEADLESS |
+                               Aspen::Engine::START_FLAGS::CREATE_PHYSICS |
+                               Aspen::Engine::START_FLAGS::CREATE_GAMESTATEMANAGER);
+  double cellSize = engine.FindChildOfType<Aspen::Physics::Physics>()->GetCellSize();
+
+  std::printf("%10s %18s %18s %8s\n", "colliders", "one cell (ms)", "grid (ms)", "match");
+  for (int count : counts)
+  {
+    Result all = Run(engine, count, ONE_CELL, frames);
+    Result grid = Run(engine, count, cellSize, frames);
+    std::printf("%10d %18.2f %18.2f %8s\n", count, all.ms, grid.ms, all.checksum == grid.checksum ? "yes" : "NO");
+  }
+  return 0;
+}
@@ -2,6 +2,7 @@
 #define __AUDIO_HPP
 
 #include <SDL2/SDL_mixer.h>
+#include <memory>
 #include "Object.hpp"
 
 /// \brief Aspen engine namespace
@@ -16,10 +17,19 @@ class SoundEffect : public Object::Object
   /// \brief Path to the soundeffect file
   std::string _path;
   /// \brief Loaded sound chunk
-  Mix_Chunk *_sound;
+  ///        Shared with copies made by Clone, and freed once the last of them lets go of it
+  std::shared_ptr<Mix_Chunk> _sound;
   /// \brief Channels the sound has been played on
   std::vector<unsigned> _channels;
 
+protected:
+  /// \brief Clone constructor
+  ///        Used by Clone
+  ///        Shares other's sound chunk instead of loading it again
+  /// \param other SoundEffect to copy
+  /// \param parent Parent Object creating the copy
+  SoundEffect(const SoundEffect &other, Object *parent);
+
 public:
   /// \brief Constructor
   /// \param parent Parent Object creating this Object
@@ -34,6 +44,11 @@ public:
   ///             Set by derived classes to a string representation of their type
   SoundEffect(std::string path, Object *parent = nullptr, std::string name = "SoundEffect");
 
+  /// \brief Creates a copy of this Object without its children
+  /// \param parent Parent Object creating the copy
+  /// \return Copy of this Object
+  Object *Clone(Object *parent = nullptr) const;
+
   /// \brief Shuts down and invalidates Object and all of its children
   ///        An invalid child Object will be deleted by their parent after they update
   void End();
@@ -78,7 +93,7 @@ public:
 class Music : public Object::Object
 {
   /// \brief Tracks the last music file that was played
-  static Music *_lastPlayed;
+  static Aspen::Object::Handle<Music> _lastPlayed;
   /// \brief Path of this music file
   std::string _path;
   /// \brief loaded music file
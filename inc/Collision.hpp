@@ -1,5 +1,6 @@
 #ifndef __COLLISION_HPP
 #define __COLLISION_HPP
+#include "Handle.hpp"
 
 /// \brief Aspen engine namespace
 namespace Aspen
@@ -29,7 +30,8 @@ public:
   ///        This class should be discarded unless this is SUCCESS
   COLLISION_RESULT result;
   /// \brief Second collider in a collision
-  Collider *collider;
+  ///        Stops resolving if the collider is ended or destroyed, so collisions can be kept safely
+  Object::Handle<Collider> collider;
   /// \brief Relative x position of the collision
   double collisionX;
   /// \brief Relative y position of the collision
@@ -18,6 +18,16 @@ class PlayerController_8Way : public Object::Object
   double _acceleration;
   /// \brief Max speed
   double _speed;
+  /// \brief Lists this in Aspen::Object::Registry<PlayerController_8Way>
+  Aspen::Object::RegistryEntry<PlayerController_8Way> _registryEntry;
+
+protected:
+  /// \brief Clone constructor
+  ///        Used by Clone
+  ///        Unlike the other constructors this doesn't create Axis children, since CloneTree copies them
+  /// \param other PlayerController_8Way to copy
+  /// \param parent Parent Object creating the copy
+  PlayerController_8Way(const PlayerController_8Way &other, Object *parent);
 
 public:
   /// \brief Constructor
@@ -38,10 +48,19 @@ public:
   ///             Set by derived classes to a string representation of their type
   PlayerController_8Way(SDL_Keycode up, SDL_Keycode down, SDL_Keycode left, SDL_Keycode right, double speed, double acceleration, Object *parent = nullptr, std::string name = "PlayerController_8Way");
 
+  /// \brief Creates a copy of this Object without its children
+  /// \param parent Parent Object creating the copy
+  /// \return Copy of this Object
+  Object *Clone(Object *parent = nullptr) const;
+
   /// \brief Updates this object and all of its children
   ///        Derived classes should call or reimplement this at some point in their operator()
   ///        This won't run if the Object isn't Active
   void operator()();
+  /// \brief Applies input from the Axis children to the parent's Rigidbody
+  ///        Called by operator(), or by Engine::Engine::Tick while the Engine has a fixed timestep
+  /// \param dt Time to simulate in 60ths of a second
+  void Step(double dt);
 
   /// \brief Gets the controller's acceleration
   /// \return _acceleration
@@ -77,6 +96,20 @@ class PlayerController_Sidescroller : public Object::Object
   double _jumpRemaining;
   /// \brief Jump key
   SDL_Keycode _jumpKey;
+  /// \brief True if the jump key was pressed since the last Step
+  bool _jumpPressed;
+  /// \brief True if the jump key was released since the last Step
+  bool _jumpReleased;
+  /// \brief Lists this in Aspen::Object::Registry<PlayerController_Sidescroller>
+  Aspen::Object::RegistryEntry<PlayerController_Sidescroller> _registryEntry;
+
+protected:
+  /// \brief Clone constructor
+  ///        Used by Clone
+  ///        Unlike the other constructors this doesn't create Axis children, since CloneTree copies them
+  /// \param other PlayerController_Sidescroller to copy
+  /// \param parent Parent Object creating the copy
+  PlayerController_Sidescroller(const PlayerController_Sidescroller &other, Object *parent);
 
 public:
   /// \brief Constructor
@@ -97,10 +130,19 @@ public:
   ///             Set by derived classes to a string representation of their type
   PlayerController_Sidescroller(SDL_Keycode left, SDL_Keycode right, SDL_Keycode jump, double speed, double acceleration, double jumpStrength, double jumpHeight, Object *parent = nullptr, std::string name = "PlayerController_Sidescroller");
 
+  /// \brief Creates a copy of this Object without its children
+  /// \param parent Parent Object creating the copy
+  /// \return Copy of this Object
+  Object *Clone(Object *parent = nullptr) const;
+
   /// \brief Updates this object and all of its children
   ///        Derived classes should call or reimplement this at some point in their operator()
   ///        This won't run if the Object isn't Active
   void operator()();
+  /// \brief Applies input from the Axis children to the parent's Rigidbody
+  ///        Called by operator(), or by Engine::Engine::Tick while the Engine has a fixed timestep
+  /// \param dt Time to simulate in 60ths of a second
+  void Step(double dt);
 
   /// \brief Gets the controller's acceleration
   /// \return _acceleration
@@ -2,6 +2,7 @@
 #define __ENGINE_HPP
 #include "Version.hpp"
 #include "Object.hpp"
+#include <chrono>
 
 /// \brief Aspen engine namespace
 namespace Aspen
@@ -14,6 +15,14 @@ namespace Engine
 extern const Version::Version VERSION;
 /// \brief SDL_Init flags
 extern const unsigned SDL_INIT_FLAGS;
+/// \brief SDL_Init flags used when the Engine is HEADLESS
+extern const unsigned SDL_INIT_FLAGS_HEADLESS;
+/// \brief Longest frame in seconds that is fed to the fixed timestep accumulator
+///        Keeps a long stall from queueing up more ticks than can be caught up on
+extern const double MAX_FRAME_TIME;
+/// \brief Length in seconds of every frame of a HEADLESS Engine without a fixed timestep
+///        Keeps headless runs deterministic no matter how fast they actually run
+extern const double NOMINAL_FRAME_TIME;
 
 /// \brief START_FLAGS namespace
 ///        Contains const ints to be passed to Engine's constructor
@@ -35,16 +44,20 @@ const int CREATE_EVENTHANDLER        = 0b0000000000001000;
 /// \brief Gives the child EventHandler a QuitEventListener
 ///        Must be passed with CREATE_EVENTHANDLER
 const int CREATE_EVENT_QUIT          = 0b0000000000010000;
-/// \brief Gives the child EventHandler a KeyEventListener for each alphabet key
+/// \brief Gives the child EventHandler a KeyboardEventListener to track the alphabet keys
+///        Any CREATE_EVENT_KEYS flag creates the same KeyboardEventListener, which tracks every key
 ///        Must be passed with CREATE_EVENTHANDLER
 const int CREATE_EVENT_KEYS_ALPHA    = 0b0000000000100000;
-/// \brief Gives the child EventHandler a KeyEventListener for each numeric key
+/// \brief Gives the child EventHandler a KeyboardEventListener to track the numeric keys
+///        Any CREATE_EVENT_KEYS flag creates the same KeyboardEventListener, which tracks every key
 ///        Must be passed with CREATE_EVENTHANDLER
 const int CREATE_EVENT_KEYS_NUM      = 0b0000000001000000;
-/// \brief Gives the child EventHandler a KeyEventListener for each special key
+/// \brief Gives the child EventHandler a KeyboardEventListener to track the special keys
+///        Any CREATE_EVENT_KEYS flag creates the same KeyboardEventListener, which tracks every key
 ///        Must be passed with CREATE_EVENTHANDLER
 const int CREATE_EVENT_KEYS_SPECIAL  = 0b0000000010000000;
-/// \brief Gives the child EventHandler a KeyEventListener for each function key
+/// \brief Gives the child EventHandler a KeyboardEventListener to track the function keys
+///        Any CREATE_EVENT_KEYS flag creates the same KeyboardEventListener, which tracks every key
 ///        Must be passed with CREATE_EVENTHANDLER
 const int CREATE_EVENT_KEYS_FUNCTION = 0b0000000100000000;
 /// \brief Synonym for (CREATE_EVENT_KEYS_ALPHA | CREATE_EVENT_KEYS_NUM | CREATE_EVENT_KEYS_SPECIAL | CREATE_EVENT_KEYS_FUNCTION | CREATE_EVENT_KEYS_ALL)
@@ -64,10 +77,15 @@ const int CREATE_PHYSICS             = 0b0000100000000000;
 const int CREATE_GAMESTATEMANAGER    = 0b0001000000000000;
 /// \brief Creates an Audio::Audio Object as a child
 const int CREATE_AUDIO               = 0b0010000000000000;
+/// \brief Runs without a window, renderer or audio device
+///        CREATE_GRAPHICS and CREATE_AUDIO are ignored and Time doesn't cap the framerate
+///        While FixedTimestep() > 0, every frame runs exactly one tick so simulation runs as fast as possible
+///        Otherwise every frame is counted as NOMINAL_FRAME_TIME long
+const int HEADLESS                   = 0b0100000000000000;
 /// \brief Determines if children of the engine should debug
 const int DEBUGGING_ON               = 0b1000000000000000;
-/// \brief Synonym for all START_FLAGS
-const int ALL                        = 0b1111111111111111;
+/// \brief Synonym for all START_FLAGS except HEADLESS
+const int ALL                        = 0b1011111111111111;
 } // namespace START_FLAGS
 
 /// \brief Engine class
@@ -75,10 +93,24 @@ class Engine : public Object::Object
 {
   /// \brief Determines if the Engine has debugging turned on
   bool _debugging = false;
+  /// \brief Determines if the Engine is running without a window, renderer or audio device
+  bool _headless = false;
   /// \brief Total number of Engine Objects
   static unsigned _ecount;
   /// \brief First created Engine object
   static Engine *_main;
+  /// \brief Length of a simulation tick in seconds
+  ///        0 if simulation runs once per frame
+  double _timestep = 0.0;
+  /// \brief Time in seconds not yet simulated by a tick
+  double _accumulator = 0.0;
+  /// \brief Number of ticks run since the fixed timestep was set
+  unsigned long long _ticks = 0;
+  /// \brief Time the last frame started
+  std::chrono::steady_clock::time_point _lastFrame = std::chrono::steady_clock::now();
+  /// \brief Pre-order list of the descendants updated each frame
+  ///        Kept between frames so the tree is only walked again after it changes
+  Aspen::Object::TraversalCache _traversal;
 
 public:
   /// \brief Constructor
@@ -105,6 +137,29 @@ public:
   ///        This won't run if the Object isn't Active
   void operator()();
 
+  /// \brief Runs a single simulation tick of _timestep seconds
+  ///        Steps Physics, the player controllers, Rigidbodies and Animations under this Engine
+  ///        Objects in an update rate group are only stepped on the ticks their group is due, by all of the ticks since
+  ///        their group was last stepped
+  ///        Called by operator() as many times as needed to catch up while FixedTimestep() > 0
+  void Tick();
+
+  /// \brief Gets the length of a simulation tick
+  /// \return _timestep
+  double FixedTimestep();
+  /// \brief Sets the length of a simulation tick
+  ///        While this is above 0, simulation runs in ticks of this length no matter the framerate,
+  ///        and Transforms are interpolated between the last two ticks while the frame is drawn
+  ///        0 runs simulation once per frame
+  /// \param timestep New tick length in seconds
+  void FixedTimestep(double timestep);
+  /// \brief Gets how far the current frame is between the last tick and the next one
+  /// \return Fraction of a tick in [0, 1)
+  double TickProgress();
+  /// \brief Gets the number of ticks run since the fixed timestep was set
+  /// \return _ticks
+  unsigned long long Ticks();
+
   /// \brief Determines if the Engine has debugging turned on
   /// \return _debugging
   bool Debug();
@@ -112,6 +167,10 @@ public:
   /// \param newval New debugging value
   void Debug(bool newval);
 
+  /// \brief Determines if the Engine is running without a window, renderer or audio device
+  /// \return _headless
+  bool Headless();
+
   /// \brief Fills out the Debugger if it exists with this Object's information
   ///        Derived classes should call their base class's version of this method
   void PopulateDebugger();
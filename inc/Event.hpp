@@ -15,6 +15,9 @@ namespace Event
 ///        Parented by EventHandler and used to moduly handle SDL_Events
 class EventListener : public Object::Object
 {
+  /// \brief Lists this in Aspen::Object::Registry<EventListener>
+  Aspen::Object::RegistryEntry<EventListener> _registryEntry;
+
 public:
   /// \brief Constructor
   ///        Derived classes should call this in their constructors' initialization list
@@ -63,8 +66,32 @@ public:
   void PopulateDebugger();
 };
 
+/// \brief KeyboardEventListener class
+///        Passes every key event to the keyboard state table behind Input::GetKey()
+class KeyboardEventListener : public EventListener
+{
+public:
+  /// \brief Constructor
+  ///        Derived classes should call this in their constructors' initialization list
+  /// \param parent Parent Object to be passed to Object constructor
+  /// \param name Object name
+  ///             Set by derived classes to a string representation of their type
+  KeyboardEventListener(Object *parent = nullptr, std::string name = "KeyboardEventListener");
+  /// \brief Destructor
+  ~KeyboardEventListener();
+
+  /// \brief Updates the Input::Key of the key in a SDL_KEYDOWN or SDL_KEYUP event
+  /// \param event Event to handle
+  void Handle(SDL_Event *event);
+
+  /// \brief Fills out the Debugger if it exists with this Object's information
+  ///        Derived classes should call their base class's version of this method
+  void PopulateDebugger();
+};
+
 /// \brief KeyEventListener class
-///        Controls Input::Keys from Input::GetKey()
+///        Controls a single Input::Key from Input::GetKey()
+///        KeyboardEventListener controls every key at once and should be preferred
 class KeyEventListener : public EventListener
 {
   /// \brief Key to pass Input::GetKey()
@@ -87,15 +114,10 @@ public:
   /// \brief Destructor
   ~KeyEventListener();
 
-  /// \brief Updates this object and all of its children
-  ///        Derived classes should call or reimplement this at some point in their operator()
-  ///        This won't run if the Object isn't Active
-  void operator()();
-
   /// \brief Sets _key
   /// \param k Key to control
   void SetKey(SDL_Keycode k);
-  /// \brief Controls the state of Input::Key in the map obtained by Input::GetKey(_key)
+  /// \brief Controls the state of Input::Key obtained by Input::GetKey(_key)
   ///        Does nothing if _key == SDLK_UNKNOWN
   /// \param event Event to handle
   void Handle(SDL_Event *event);
@@ -121,6 +143,9 @@ public:
   /// \brief Destructor
   ~MouseEventListener();
 
+  /// \brief This class's operator() leaves the children to the update pass (see Object::LeavesChildrenToPass)
+  typedef MouseEventListener PassUpdatedClass;
+
   /// \brief Updates this object and all of its children
   ///        Derived classes should call or reimplement this at some point in their operator()
   ///        This won't run if the Object isn't Active
@@ -138,6 +163,7 @@ public:
 
 /// \brief EventHandler class
 ///        Passes SDL_Events to children EventListeners
+///        Clears Input::Keys' pressed and released states once per frame before polling
 class EventHandler : public Object::Object
 {
 public:
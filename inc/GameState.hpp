@@ -36,6 +36,15 @@ public:
   /// \brief Sets the state's name
   /// \param state New state name
   void StateName(std::string state);
+
+  /// \brief Loads a scene file and adds its Objects to this state (see Scene::Load)
+  /// \param path Path of the scene file
+  /// \return True if the scene was loaded
+  bool LoadScene(std::string path);
+  /// \brief Saves this state's children and their descendants to a scene file (see Scene::Save)
+  /// \param path Path of the scene file
+  /// \return True if the scene was saved
+  bool SaveScene(std::string path);
 };
 
 /// \brief GameStateManager class
@@ -61,7 +70,7 @@ public:
     GameState *state = dynamic_cast<GameState *>(temp);
     if (state)
     {
-      AddChild(state);
+      AddChild(temp);
       state->SetActive(active);
     }
     else
@@ -5,7 +5,11 @@
 #include <SDL2/SDL_ttf.h>
 #include "Log.hpp"
 #include "Object.hpp"
+#include "Transform.hpp"
 #include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 /// \brief Aspen engine namespace
 namespace Aspen
@@ -122,6 +126,15 @@ protected:
   Color _c;
   /// \brief Determines if the object is filled or outlined
   bool _fill;
+  /// \brief Position, rotation and scale of this Object
+  ///        Returned by GetTransform
+  Aspen::Transform::Transform _transformComponent;
+
+  /// \brief Clone constructor
+  ///        Used by Clone
+  /// \param other Geometry to copy
+  /// \param parent Parent Object creating the copy
+  Geometry(const Geometry &other, Object *parent);
 
 public:
   /// \brief Constructor
@@ -140,6 +153,11 @@ public:
   /// \brief Destructor
   ~Geometry();
 
+  /// \brief Creates a copy of this Object without its children
+  /// \param parent Parent Object creating the copy
+  /// \return Copy of this Object
+  Object *Clone(Object *parent = nullptr) const;
+
   /// \brief Gets the color of the object
   /// \return Reference to _c
   Color &Color();
@@ -171,6 +189,13 @@ class Rectangle : public Geometry
   /// \brief Rectangle to represent
   SDL_Rect _rect;
 
+protected:
+  /// \brief Clone constructor
+  ///        Used by Clone
+  /// \param other Rectangle to copy
+  /// \param parent Parent Object creating the copy
+  Rectangle(const Rectangle &other, Object *parent);
+
 public:
   /// \brief Constructor
   /// \param parent Parent Object creating this Object
@@ -189,6 +214,14 @@ public:
   /// \brief Destructor
   ~Rectangle();
 
+  /// \brief Creates a copy of this Object without its children
+  /// \param parent Parent Object creating the copy
+  /// \return Copy of this Object
+  Object *Clone(Object *parent = nullptr) const;
+
+  /// \brief This class's operator() leaves the children to the update pass (see Object::LeavesChildrenToPass)
+  typedef Rectangle PassUpdatedClass;
+
   /// \brief Updates this object and all of its children
   ///        Derived classes should call or reimplement this at some point in their operator()
   ///        This won't run if the Object isn't Active
@@ -209,6 +242,13 @@ class Point : public Geometry
   /// \brief Point to represent
   SDL_Point _point;
 
+protected:
+  /// \brief Clone constructor
+  ///        Used by Clone
+  /// \param other Point to copy
+  /// \param parent Parent Object creating the copy
+  Point(const Point &other, Object *parent);
+
 public:
   /// \brief Constructor
   /// \param parent Parent Object creating this Object
@@ -226,6 +266,14 @@ public:
   /// \brief Destructor
   ~Point();
 
+  /// \brief Creates a copy of this Object without its children
+  /// \param parent Parent Object creating the copy
+  /// \return Copy of this Object
+  Object *Clone(Object *parent = nullptr) const;
+
+  /// \brief This class's operator() leaves the children to the update pass (see Object::LeavesChildrenToPass)
+  typedef Point PassUpdatedClass;
+
   /// \brief Updates this object and all of its children
   ///        Derived classes should call or reimplement this at some point in their operator()
   ///        This won't run if the Object isn't Active
@@ -252,6 +300,13 @@ class Line : public Geometry
   ///        Center point: _start * _center + _end * (1 - _center)
   float _center;
 
+protected:
+  /// \brief Clone constructor
+  ///        Used by Clone
+  /// \param other Line to copy
+  /// \param parent Parent Object creating the copy
+  Line(const Line &other, Object *parent);
+
 public:
   /// \brief Constructor
   /// \param parent Parent Object creating this Object
@@ -271,6 +326,14 @@ public:
   /// \brief Destructor
   ~Line();
 
+  /// \brief Creates a copy of this Object without its children
+  /// \param parent Parent Object creating the copy
+  /// \return Copy of this Object
+  Object *Clone(Object *parent = nullptr) const;
+
+  /// \brief This class's operator() leaves the children to the update pass (see Object::LeavesChildrenToPass)
+  typedef Line PassUpdatedClass;
+
   /// \brief Updates this object and all of its children
   ///        Derived classes should call or reimplement this at some point in their operator()
   ///        This won't run if the Object isn't Active
@@ -295,17 +358,116 @@ public:
   void PopulateDebugger();
 };
 
-/// \brief Sprite class
-class Sprite : public Object::Object
+/// \brief Texture class
+///        Image loaded once by TextureCache and shared between every Sprite using the same path
+///        Always owned by a std::shared_ptr made by TextureCache
+class Texture : public std::enable_shared_from_this<Texture>
 {
-  /// \brief Path of file loaded as a sprite
+  /// \brief Path of file loaded
   std::string _path;
   /// \brief Surface loaded from _path
+  ///        Freed once _tex has been created from it
   SDL_Surface *_surface;
   /// \brief Texture generated from _surface
   SDL_Texture *_tex;
+  /// \brief Renderer _tex was created with
+  SDL_Renderer *_renderer;
+  /// \brief Width of the loaded image
+  int _width;
+  /// \brief Height of the loaded image
+  int _height;
+
+public:
+  /// \brief Constructor
+  ///        Doesn't load anything until Load is called
+  /// \param path Path of file to load
+  Texture(std::string path);
+  /// \brief Destructor
+  ///        Frees _surface and _tex
+  ~Texture();
+  /// \brief Textures are shared through TextureCache instead of being copied
+  Texture(const Texture &) = delete;
+  /// \brief Textures are shared through TextureCache instead of being copied
+  Texture &operator=(const Texture &) = delete;
+
+  /// \brief Loads _surface from _path
+  /// \return True if the image was loaded
+  bool Load();
+  /// \brief Generates _tex from _surface with the given renderer and frees _surface
+  ///        Does nothing if _tex was already generated with the same renderer
+  ///        Reloads _surface from _path if it was already freed
+  ///        Deferred until the parallel update finishes if called from one of its jobs
+  /// \param renderer Renderer to generate _tex with
+  /// \return True if _tex is ready to draw, or will be once a deferred upload runs
+  bool Upload(SDL_Renderer *renderer);
+  /// \brief Destroys _tex
+  ///        Must be called before the renderer it was created with is destroyed
+  void Unload();
+
+  /// \brief Gets the path of the loaded file
+  /// \return Const reference to _path
+  const std::string &GetPath() const;
+  /// \brief Gets the loaded surface
+  /// \return _surface, or nullptr once _tex has been generated
+  SDL_Surface *GetSurface();
+  /// \brief Gets the generated texture
+  /// \return _tex
+  SDL_Texture *GetTexture();
+  /// \brief Gets the width of the loaded image
+  /// \return _width
+  int GetWidth() const;
+  /// \brief Gets the height of the loaded image
+  /// \return _height
+  int GetHeight() const;
+};
+
+/// \brief TextureCache class
+///        Caches loaded Textures by path so each file is only decoded and uploaded once
+///        Textures are freed once the last Sprite using them lets go of them
+class TextureCache
+{
+  /// \brief Map of paths to loaded Textures
+  std::map<std::string, std::weak_ptr<Texture>> _textures;
+  /// \brief Guards _textures so Sprites can be created by parallel update jobs
+  std::mutex _mutex;
+
+public:
+  /// \brief Gets a shared Texture for the given path
+  ///        Loads the file if no Sprite is using it yet
+  /// \param path Path of file to load
+  /// \return Shared Texture, or nullptr if the file couldn't be loaded
+  std::shared_ptr<Texture> Get(std::string path);
+  /// \brief Destroys every Texture's _tex
+  ///        Called by Graphics before its renderer is destroyed
+  void Unload();
+  /// \brief Gets the number of Textures currently in use
+  /// \return Number of Textures currently in use
+  unsigned Count();
+};
+
+/// \brief Sprite class
+class Sprite : public Object::Object
+{
+  /// \brief Path of file loaded as a sprite
+  std::string _path;
+  /// \brief Texture loaded from _path
+  ///        Shared with every other Sprite loaded from the same path
+  std::shared_ptr<Texture> _texture;
   /// \brief Rectangle to draw _tex with
   SDL_Rect _rect;
+  /// \brief Lists this in Aspen::Object::Registry<Sprite>
+  Aspen::Object::RegistryEntry<Sprite> _registryEntry;
+  /// \brief Position, rotation and scale of this Object
+  ///        Returned by GetTransform
+  Aspen::Transform::Transform _transformComponent;
+
+protected:
+  /// \brief Clone constructor
+  ///        Used by Clone
+  ///        Shares other's Texture instead of loading it again
+  /// \param other Sprite to copy
+  /// \param parent Parent Object creating the copy
+  Sprite(const Sprite &other, Object *parent);
 
 public:
   /// \brief Constructor
@@ -323,10 +485,18 @@ public:
   /// \brief Destructor
   ~Sprite();
 
+  /// \brief Creates a copy of this Object without its children
+  /// \param parent Parent Object creating the copy
+  /// \return Copy of this Object
+  Object *Clone(Object *parent = nullptr) const;
+
   /// \brief Shuts down and invalidates Object and all of its children
   ///        An invalid child Object will be deleted by their parent after they update
   void End();
 
+  /// \brief This class's operator() leaves the children to the update pass (see Object::LeavesChildrenToPass)
+  typedef Sprite PassUpdatedClass;
+
   /// \brief Draws the sprite to the parent Object's window if parent is of type Graphics
   void operator()();
 
@@ -341,11 +511,15 @@ public:
   /// \return Const reference to _path
   const std::string &GetPath() const;
   /// \brief Gets the loaded surface
-  /// \return _surface
+  ///        This is freed once the texture has been generated
+  /// \return _texture's surface
   SDL_Surface *GetSurface();
   /// \brief Gets the generated texture
-  /// \return _tex
+  /// \return _texture's texture
   SDL_Texture *GetTexture();
+  /// \brief Gets the shared Texture
+  /// \return Const reference to _texture
+  const std::shared_ptr<Texture> &GetSharedTexture() const;
 
   /// \brief Gets the rectangle _tex is drawn to
   /// \return Reference to _rect
@@ -365,6 +539,13 @@ class UniformSpritesheet : public Sprite
   /// \brief Total number of frames of the spritesheet
   int _framecount;
 
+protected:
+  /// \brief Clone constructor
+  ///        Used by Clone
+  /// \param other UniformSpritesheet to copy
+  /// \param parent Parent Object creating the copy
+  UniformSpritesheet(const UniformSpritesheet &other, Object *parent);
+
 public:
   /// \brief Constructor
   /// \param parent Parent Object to be passed to Object constructor
@@ -402,6 +583,14 @@ public:
   /// \brief Destructor
   ~UniformSpritesheet();
 
+  /// \brief Creates a copy of this Object without its children
+  /// \param parent Parent Object creating the copy
+  /// \return Copy of this Object
+  Object *Clone(Object *parent = nullptr) const;
+
+  /// \brief This class's operator() leaves the children to the update pass (see Object::LeavesChildrenToPass)
+  typedef UniformSpritesheet PassUpdatedClass;
+
   /// \brief Draws the sprite to the parent Object's window if parent is of type Graphics
   void operator()();
 
@@ -430,6 +619,19 @@ class Animation : public Object::Object
   float _remainingDelay;
   /// \brief True if the animation just looped
   bool _done;
+  /// \brief Lists this in Aspen::Object::Registry<Animation>
+  Aspen::Object::RegistryEntry<Animation> _registryEntry;
+  /// \brief Position, rotation and scale of this Object
+  ///        Returned by GetTransform
+  Aspen::Transform::Transform _transformComponent;
+
+protected:
+  /// \brief Clone constructor
+  ///        Used by Clone
+  ///        Unlike the other constructors this doesn't add a spritesheet, since CloneTree copies the children
+  /// \param other Animation to copy
+  /// \param parent Parent Object creating the copy
+  Animation(const Animation &other, Object *parent);
 
 public:
   /// \brief Constructor
@@ -449,8 +651,17 @@ public:
   /// \brief Destructor
   ~Animation();
 
+  /// \brief Creates a copy of this Object without its children
+  /// \param parent Parent Object creating the copy
+  /// \return Copy of this Object
+  Object *Clone(Object *parent = nullptr) const;
+
   /// \brief Draws the sprite to the parent Object's window if parent is of type Graphics
   void operator()();
+  /// \brief Advances the current frame
+  ///        Called by operator(), or by Engine::Engine::Tick while the Engine has a fixed timestep
+  /// \param dt Time to advance by in seconds
+  void Step(double dt);
 
   /// \brief Gets the total number of frames
   ///        Calculates this by combining the frames of all Sprite and UniformSpritesheet children
@@ -523,7 +734,10 @@ class Graphics;
 class Camera : public Object::Object
 {
   /// \brief Graphics object currently using the Camera
-  Graphics *_gfx;
+  Aspen::Object::Handle<Graphics> _gfx;
+  /// \brief Position, rotation and scale of this Object
+  ///        Returned by GetTransform
+  Aspen::Transform::Transform _transformComponent;
 
 public:
   /// \brief Constructor
@@ -571,6 +785,53 @@ class Graphics : public Object::Object
   Camera *_camera;
   /// \brief First created Graphics object
   static Graphics *_main;
+  /// \brief Textures shared between all Sprites
+  static TextureCache _textureCache;
+
+  /// \brief Sprite queued to be drawn when the sprite batches are flushed
+  class SpriteQuad
+  {
+  public:
+    /// \brief Area of the texture to draw
+    SDL_Rect src;
+    /// \brief Area of the window to draw to
+    SDL_Rect dst;
+    /// \brief Clockwise rotation in radians around the center of dst
+    double angle;
+  };
+  /// \brief Run of consecutively queued quads that share a texture
+  class SpriteBatch
+  {
+  public:
+    /// \brief Texture the quads are drawn with
+    ///        Held so it outlives a Sprite destroyed before the batch is flushed
+    std::shared_ptr<Texture> texture;
+    /// \brief Index of the batch's first quad in _quads
+    unsigned first;
+    /// \brief Number of quads in the batch
+    unsigned count;
+  };
+  /// \brief Sprites queued since the last flush in the order they were drawn
+  std::vector<SpriteQuad> _quads;
+  /// \brief Runs of _quads that share a texture
+  std::vector<SpriteBatch> _batches;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  /// \brief Vertices of the batch being flushed
+  std::vector<SDL_Vertex> _vertices;
+  /// \brief Indices of two triangles for each quad, shared by every batch
+  std::vector<int> _indices;
+#endif
+  /// \brief Number of sprites drawn this frame
+  unsigned _spriteCount;
+  /// \brief Number of renderer calls made to draw this frame's sprites
+  unsigned _spriteDrawCalls;
+
+  /// \brief Queues a quad to be drawn by FlushSprites
+  /// \param texture Texture to draw with
+  /// \param src Area of the texture to draw
+  /// \param dst Area of the window to draw to
+  /// \param angle Clockwise rotation in radians around the center of dst
+  void QueueSprite(const std::shared_ptr<Texture> &texture, SDL_Rect src, SDL_Rect dst, double angle);
 
 public:
   /// \brief Constructor
@@ -592,6 +853,9 @@ public:
   /// \brief Gets the main graphics object
   /// \return _main
   static Graphics *Get();
+  /// \brief Gets the Textures shared between all Sprites
+  /// \return Reference to _textureCache
+  static TextureCache &GetTextureCache();
 
   /// \brief Updates this object and all of its children
   ///        Derived classes should call or reimplement this at some point in their operator()
@@ -620,6 +884,7 @@ public:
   SDL_Renderer *GetRenderer();
 
   /// \brief Draws a given Rectangle
+  ///        Every Draw function is deferred until the parallel update finishes if called from one of its jobs
   /// \param rect Rectangle to draw
   void DrawRectangle(Rectangle *rect);
   /// \brief Draws a given Rectangle
@@ -645,13 +910,19 @@ public:
   /// \param c Color to draw in
   void DrawLine(SDL_Point *start, SDL_Point *end, Color c);
 
-  /// \brief Draws a given Sprite
+  /// \brief Queues a given Sprite to be drawn
+  ///        Sprites are drawn in the order they were queued when FlushSprites is called
   /// \param sprite Sprite to draw
   void DrawSprite(Sprite *sprite);
-  /// \brief Draws a given Sprite
+  /// \brief Queues a given Sprite to be drawn
+  ///        Sprites are drawn in the order they were queued when FlushSprites is called
   /// \param sprite Sprite to draw
   /// \param clip Clipping rectangle to apply as a mask
   void DrawSprite(Sprite *sprite, SDL_Rect clip);
+  /// \brief Draws every queued Sprite
+  ///        Each run of consecutive Sprites that share a texture is drawn with a single call when SDL supports SDL_RenderGeometry
+  ///        Called before anything else is drawn so Sprites stay in order with it, and at the end of each frame
+  void FlushSprites();
 
   /// \brief Draws text
   /// \param text Text to draw
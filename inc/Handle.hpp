@@ -0,0 +1,121 @@
+#ifndef __HANDLE_HPP
+#define __HANDLE_HPP
+#include <type_traits>
+
+/// \brief Aspen engine namespace
+namespace Aspen
+{
+/// \brief Object namespace
+///        Contains the Object base class for most classes of Aspen
+namespace Object
+{
+/// \brief Forward declaration
+class Object;
+
+/// \brief Slot index of a Handle that doesn't reference anything
+const unsigned HANDLE_NONE = 0xFFFFFFFF;
+
+/// \brief Looks up the Object in a slot of the handle table
+///        Used by Handle::Get
+/// \param slot Slot index
+/// \param generation Generation the slot had when the handle was made
+/// \return Object in the slot
+///         nullptr if the Object has been destroyed or ended
+Object *ResolveHandle(unsigned slot, unsigned generation);
+
+/// \brief Safe reference to an Object
+///        Holds the index of the Object's slot in the handle table and the slot's generation
+///        Destroying an Object bumps its slot's generation, so handles to it stop resolving instead of dangling
+///        Handles can be kept across frames instead of finding the Object again every frame
+/// \tparam T Type of Object referenced
+///           Must inherit Object
+template <typename T>
+class Handle
+{
+  template <typename U>
+  friend class Handle;
+
+  /// \brief Index of the Object's slot in the handle table
+  unsigned _slot;
+  /// \brief Generation of the slot when this handle was made
+  unsigned _generation;
+
+public:
+  /// \brief Constructor
+  ///        Makes a handle that doesn't reference anything
+  Handle()
+      : _slot(HANDLE_NONE), _generation(0)
+  {
+  }
+  /// \brief Constructor
+  /// \param object Object to reference
+  ///               nullptr makes a handle that doesn't reference anything
+  Handle(T *object)
+      : _slot(HANDLE_NONE), _generation(0)
+  {
+    if (object)
+    {
+      _slot = object->HandleSlot();
+      _generation = object->HandleGeneration();
+    }
+  }
+  /// \brief Converting constructor
+  ///        Allows a handle to a derived type to be used as a handle to its base
+  /// \tparam U Type referenced by other
+  ///           Must be convertible to T
+  /// \param other Handle to copy
+  template <typename U, typename = typename std::enable_if<std::is_convertible<U *, T *>::value>::type>
+  Handle(const Handle<U> &other)
+      : _slot(other._slot), _generation(other._generation)
+  {
+  }
+
+  /// \brief Gets the referenced Object
+  /// \return Referenced Object
+  ///         nullptr if it has been destroyed or ended, or if nothing is referenced
+  T *Get() const
+  {
+    if (_slot == HANDLE_NONE)
+      return nullptr;
+    return static_cast<T *>(ResolveHandle(_slot, _generation));
+  }
+  /// \brief Gets the referenced Object
+  /// \return Referenced Object
+  ///         nullptr if it has been destroyed or ended, or if nothing is referenced
+  T *operator->() const
+  {
+    return Get();
+  }
+  /// \brief Determines if the referenced Object still exists and hasn't ended
+  /// \return True if Get would return an Object
+  explicit operator bool() const
+  {
+    return Get() != nullptr;
+  }
+
+  /// \brief Determines if two handles reference the same Object
+  /// \param other Handle to compare to
+  /// \return True if both reference the same slot and generation
+  bool operator==(const Handle &other) const
+  {
+    return _slot == other._slot && _generation == other._generation;
+  }
+  /// \brief Determines if two handles reference different Objects
+  /// \param other Handle to compare to
+  /// \return True if the handles reference different slots or generations
+  bool operator!=(const Handle &other) const
+  {
+    return !(*this == other);
+  }
+
+  /// \brief Stops referencing the Object
+  void Reset()
+  {
+    _slot = HANDLE_NONE;
+    _generation = 0;
+  }
+};
+} // namespace Object
+} // namespace Aspen
+
+#endif
@@ -60,6 +60,13 @@ class Axis : public Object::Object
   /// \brief Current value of the axis
   float _value;
 
+protected:
+  /// \brief Clone constructor
+  ///        Used by Clone
+  /// \param other Axis to copy
+  /// \param parent Parent Object creating the copy
+  Axis(const Axis &other, Object *parent);
+
 public:
   /// \brief Constructor
   /// \param parent Parent Object to be passed to Object constructor
@@ -77,6 +84,11 @@ public:
   ///             Set by derived classes to a string representation of their type
   Axis(SDL_Keycode positive = SDLK_UNKNOWN, SDL_Keycode negative = SDLK_UNKNOWN, float gravity = 0.5f, float weight = 0.5f, Object *parent = nullptr, std::string name = "Axis");
 
+  /// \brief Creates a copy of this Object without its children
+  /// \param parent Parent Object creating the copy
+  /// \return Copy of this Object
+  Object *Clone(Object *parent = nullptr) const;
+
   /// \brief Updates this object and all of its children
   ///        Derived classes should call or reimplement this at some point in their operator()
   ///        This won't run if the Object isn't Active
@@ -91,22 +103,50 @@ public:
   void PopulateDebugger();
 };
 
-/// \brief Gets a Key reference from a hidden map
-///        Creates a new Key reference if one does not yet exist for the provided SDL_Keycode
+/// \brief Gets a Key reference from the keyboard state table
+///        The table is indexed by scancode, so the keycode is first mapped to the scancode of the key that produces it
+///        Keycodes that don't map to a key get a Key that is never pressed
+/// \param k Keycode of the Key to get
+/// \return Reference to the Key
 Key &GetKey(SDL_Keycode k);
+/// \brief Gets a Key reference from the keyboard state table
+///        Scancodes name physical keys, so they don't change with the keyboard layout
+/// \param s Scancode of the Key to get
+/// \return Reference to the Key
+Key &GetKey(SDL_Scancode s);
 
 /// \brief Gets the held state of a Key
 /// \param k Keycode to check
 /// \return held state of the Key held at GetKey(k)
 bool KeyHeld(SDL_Keycode k);
+/// \brief Gets the held state of a Key
+/// \param s Scancode to check
+/// \return held state of the Key held at GetKey(s)
+bool KeyHeld(SDL_Scancode s);
 /// \brief Gets the pressed state of a Key
 /// \param k Keycode to check
 /// \return pressed state of the Key held at GetKey(k)
 bool KeyPressed(SDL_Keycode k);
+/// \brief Gets the pressed state of a Key
+/// \param s Scancode to check
+/// \return pressed state of the Key held at GetKey(s)
+bool KeyPressed(SDL_Scancode s);
 /// \brief Gets the released state of a Key
 /// \param k Keycode to check
 /// \return released state of the Key held at GetKey(k)
 bool KeyReleased(SDL_Keycode k);
+/// \brief Gets the released state of a Key
+/// \param s Scancode to check
+/// \return released state of the Key held at GetKey(s)
+bool KeyReleased(SDL_Scancode s);
+
+/// \brief Updates the keyboard state table with a key event
+/// \param event Key event to apply
+/// \return True if the Key was pressed or released by the event
+bool HandleKeyEvent(const SDL_KeyboardEvent &event);
+/// \brief Clears the pressed and released states of every Key that changed since the last call
+///        Called once per frame by Event::EventHandler before it polls events
+void ClearKeyEdges();
 
 /// \brief Gets the mouse data
 /// \return Mouse data
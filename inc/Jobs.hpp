@@ -0,0 +1,57 @@
+#ifndef __JOBS_HPP
+#define __JOBS_HPP
+#include <atomic>
+#include <functional>
+
+/// \brief Aspen engine namespace
+namespace Aspen
+{
+/// \brief Jobs namespace
+///        Work-stealing thread pool used to run independent work on several cores
+namespace Jobs
+{
+/// \brief Starts the worker threads
+///        Called automatically the first time a Group runs a job
+///        Does nothing if the workers are already running
+/// \param threads Number of worker threads
+///                0 uses one less than the number of hardware threads
+void Start(unsigned threads = 0);
+/// \brief Stops and joins the worker threads
+///        Jobs still queued are run by the next Group::Wait
+void Stop();
+/// \brief Gets the number of worker threads
+/// \return Number of running worker threads
+unsigned WorkerCount();
+
+/// \brief Set of jobs that can be waited on together
+class Group
+{
+  /// \brief Number of jobs run by this Group that haven't finished
+  std::atomic<unsigned> _pending;
+
+public:
+  /// \brief Constructor
+  Group();
+  /// \brief Destructor
+  ///        Waits for any jobs that haven't finished
+  ~Group();
+  /// \brief Copying is not allowed
+  Group(const Group &) = delete;
+  /// \brief Copying is not allowed
+  Group &operator=(const Group &) = delete;
+
+  /// \brief Queues a job on the calling thread's queue
+  ///        Idle workers steal jobs from the other end of busy threads' queues
+  /// \param job Function to run
+  void Run(std::function<void()> job);
+  /// \brief Waits for every job run by this Group to finish
+  ///        The calling thread runs queued jobs while it waits instead of sleeping
+  void Wait();
+  /// \brief Marks a job of this Group as finished
+  ///        Used by the worker that ran it
+  void Finish();
+};
+} // namespace Jobs
+} // namespace Aspen
+
+#endif
@@ -2,6 +2,7 @@
 #define __LOG_HPP
 #include <string>
 #include <sstream>
+#include <atomic>
 
 /// \brief Aspen engine namespace
 namespace Aspen
@@ -10,12 +11,28 @@ namespace Aspen
 ///        Contains Log class and references to external instantiations.
 namespace Log
 {
+/// \brief What asynchronous logging does when its queue is full
+enum OVERFLOW_POLICY
+{
+  /// \brief The message is dropped and counted
+  ///        The writer thread logs how many messages were dropped once it catches up
+  DROP,
+  /// \brief The logging thread waits for the writer thread to make room
+  BLOCK
+};
+
+/// \brief Number of messages the asynchronous logging queue holds
+extern const unsigned QUEUE_SIZE;
+
+/// \brief Forward declaration
+class AsyncWriter;
+
 /// \brief Log functor class
 ///        Used for logging information to the console
 class Log
 {
   /// \brief Current line number
-  static int _line;
+  static std::atomic<int> _line;
   /// \brief Prefix used when logging
   std::string _pre;
   /// \brief Suffix used when logging
@@ -25,6 +42,12 @@ class Log
   /// \brief Output filestream shared across all Log classes
   static std::fstream _file;
 
+  /// \brief Gets the next line number
+  /// \return _line before it was incremented
+  static int NextLine();
+
+  friend class AsyncWriter;
+
 public:
   /// \brief Constructor
   /// \param prefix Prefix used when logging
@@ -45,6 +68,23 @@ public:
   /// \param path Output filepath
   /// \return Success of opening the output file
   static bool SetFile(std::string path);
+
+  /// \brief Determines if logging is asynchronous
+  /// \return True if messages are written by a background thread
+  static bool Async();
+  /// \brief Starts or stops asynchronous logging
+  ///        While asynchronous, operator() formats the message into a lock-free queue and returns
+  ///        A background thread sleeps until messages are queued, then timestamps and writes them in batches
+  ///        Stopping waits for messages other threads are pushing and writes every queued message before returning
+  /// \param async True to start asynchronous logging, false to stop it
+  /// \param policy What to do with messages logged while the queue is full
+  static void Async(bool async, OVERFLOW_POLICY policy = DROP);
+  /// \brief Waits until every message queued so far has been written
+  ///        Does nothing unless logging is asynchronous
+  static void Flush();
+  /// \brief Gets the number of messages dropped because the queue was full
+  /// \return Total number of dropped messages
+  static unsigned long long Dropped();
 };
 
 /// \brief Used for logging debug info.
@@ -1,7 +1,14 @@
 #ifndef __OBJECT_HPP
 #define __OBJECT_HPP
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <type_traits>
 #include <vector>
 #include "Log.hpp"
+#include "Handle.hpp"
 #include "Collision.hpp"
 
 /// \brief Aspen engine namespace
@@ -28,29 +35,277 @@ class Rigidbody;
 ///        Contains the Object base class for most classes of Aspen
 namespace Object
 {
+/// \brief Flags for the phases an Object's hooks take part in
+///        Objects are only dispatched to in the phases they take part in
+namespace PHASES
+{
+/// \brief Takes part in no phases
+const unsigned NONE         = 0b00000;
+/// \brief OnEarlyUpdate
+const unsigned EARLY_UPDATE = 0b00001;
+/// \brief OnUpdate
+const unsigned UPDATE       = 0b00010;
+/// \brief OnLateUpdate
+const unsigned LATE_UPDATE  = 0b00100;
+/// \brief OnCollision
+const unsigned COLLISION    = 0b01000;
+/// \brief OnMouseEnter, OnMouseOver, OnMouseExit, OnMouseClick, and OnMouseRelease
+const unsigned MOUSE        = 0b10000;
+/// \brief Takes part in every phase
+const unsigned ALL          = 0b11111;
+} // namespace PHASES
+
+/// \brief Forward declaration
+class PhaseList;
+/// \brief Forward declaration
+class Object;
+
+/// \brief List of an Object's children
+///        Holds up to INLINE_CAPACITY children inside the Object itself and only allocates once it has more
+///        Most Objects are leaves or only have a couple of children, so most lists never allocate
+///        Has the parts of std::vector's interface Object uses so it can be used the same way
+class ChildList
+{
+public:
+  /// \brief Iterator type
+  typedef Object **iterator;
+  /// \brief Const iterator type
+  typedef Object *const *const_iterator;
+  /// \brief Number of children held without allocating
+  static const unsigned INLINE_CAPACITY = 2;
+
+private:
+  union
+  {
+    /// \brief Children while _capacity is INLINE_CAPACITY
+    Object *_inline[INLINE_CAPACITY];
+    /// \brief Children once there are more than INLINE_CAPACITY
+    Object **_heap;
+  };
+  /// \brief Number of children
+  unsigned _size;
+  /// \brief Number of children that fit before growing
+  unsigned _capacity;
+
+  /// \brief Gets the first child
+  /// \return Start of whichever storage is in use
+  Object **Data()
+  {
+    return _capacity > INLINE_CAPACITY ? _heap : _inline;
+  }
+  /// \brief Gets the first child
+  /// \return Start of whichever storage is in use
+  Object *const *Data() const
+  {
+    return _capacity > INLINE_CAPACITY ? _heap : _inline;
+  }
+
+public:
+  /// \brief Constructor
+  ChildList();
+  /// \brief Destructor
+  ~ChildList();
+  /// \brief Copying is not allowed
+  ChildList(const ChildList &) = delete;
+  /// \brief Copying is not allowed
+  ChildList &operator=(const ChildList &) = delete;
+
+  /// \brief Gets the number of children
+  /// \return _size
+  unsigned size() const
+  {
+    return _size;
+  }
+  /// \brief Determines if there are no children
+  /// \return True if _size is 0
+  bool empty() const
+  {
+    return _size == 0;
+  }
+  /// \brief Gets a child
+  /// \param index Index of the child
+  /// \return Child at index
+  Object *&operator[](unsigned index)
+  {
+    return Data()[index];
+  }
+  /// \brief Gets a child
+  /// \param index Index of the child
+  /// \return Child at index
+  Object *const &operator[](unsigned index) const
+  {
+    return Data()[index];
+  }
+  /// \brief Gets the last child
+  /// \return Last child
+  Object *&back()
+  {
+    return Data()[_size - 1];
+  }
+  /// \brief Gets an iterator to the first child
+  /// \return Iterator
+  iterator begin()
+  {
+    return Data();
+  }
+  /// \brief Gets an iterator past the last child
+  /// \return Iterator
+  iterator end()
+  {
+    return Data() + _size;
+  }
+  /// \brief Gets an iterator to the first child
+  /// \return Iterator
+  const_iterator begin() const
+  {
+    return Data();
+  }
+  /// \brief Gets an iterator past the last child
+  /// \return Iterator
+  const_iterator end() const
+  {
+    return Data() + _size;
+  }
+
+  /// \brief Adds a child to the end
+  ///        Moves the children to the heap once there are more than INLINE_CAPACITY
+  /// \param child Child to add
+  void push_back(Object *child);
+  /// \brief Removes a child while keeping the rest in order
+  /// \param it Child to remove
+  /// \return Iterator to the child after the removed one
+  iterator erase(iterator it);
+  /// \brief Makes room for at least capacity children without growing again
+  /// \param capacity Number of children to make room for
+  void reserve(unsigned capacity);
+  /// \brief Changes the number of children
+  ///        New children are nullptr
+  /// \param size New number of children
+  void resize(unsigned size);
+  /// \brief Removes every child
+  ///        Keeps the storage to reuse
+  void clear();
+};
+
+/// \brief Pre-order list of the active descendants of an Object
+///        Lets Object::UpdateTree update a whole tree in one pass over an array instead of recursing through every Object's children
+///        Rebuilt the first time it's used after an Object anywhere is added, removed, ended, activated or deactivated
+class TraversalCache
+{
+  friend class Object;
+
+  /// \brief Listed Object
+  class Entry
+  {
+  public:
+    /// \brief Object to update
+    Object *object;
+    /// \brief Index of the parent's entry
+    ///        TRAVERSAL_ROOT if the parent is the root of the list
+    unsigned parent;
+    /// \brief Index of object in its parent's children
+    unsigned childIndex;
+    /// \brief Index of the first entry after object's descendants
+    unsigned end;
+    /// \brief Determines if object was asleep and not drawing when the list was built
+    ///        Its operator() is skipped but its children are still listed
+    bool asleep;
+  };
+
+  /// \brief Object the list was built for
+  const Object *_root = nullptr;
+  /// \brief Tree version the list was built at
+  unsigned _version = 0;
+  /// \brief Listed Objects in pre-order
+  std::vector<Entry> _entries;
+
+public:
+  /// \brief Parent index of entries for children of the root
+  static const unsigned TRAVERSAL_ROOT = 0xFFFFFFFF;
+
+  /// \brief Gets the number of listed Objects
+  /// \return Number of Objects updated by the last pass that used this list
+  unsigned Size() const
+  {
+    return unsigned(_entries.size());
+  }
+};
+
 /// \brief General base class
 ///        Allows for parent/child relationship trees
 class Object
 {
+  friend class Transform::Transform;
+
 protected:
-  /// \brief Name of object
-  const std::string _name;
+  /// \brief ID of the Object's name in the name table (see InternName)
+  unsigned _nameId;
+  /// \brief Index of this Object's slot in the handle table
+  unsigned _handleSlot;
   /// \brief Total number of Objects in existence
-  static int _count;
+  static std::atomic<int> _count;
   /// \brief Parent/owner of this Object
   Object *_parent;
   /// \brief List of children Objects
-  std::vector<Object *> _children;
+  ChildList _children;
+  /// \brief Index of this Object in the EARLY_UPDATE phase list
+  unsigned _earlyIndex;
+  /// \brief Index of this Object in the LATE_UPDATE phase list
+  unsigned _lateIndex;
   /// \brief Determines if the Object is valid
   ///        Derived classes can set this to false in their Constructors if they couldn't be created properly
-  bool _valid;
+  bool _valid : 1;
   /// \brief Determines if the Object is currently updated
-  bool _active;
+  bool _active : 1;
+  /// \brief Cached result of Active
+  ///        True if this Object and every ancestor are both valid and active
+  ///        Kept up to date by RefreshActive so Active doesn't have to walk up the tree
+  bool _activeInTree : 1;
   /// \brief Determines if the Object has been started
   ///        Set to true during the first update
-  bool _started;
+  bool _started : 1;
+  /// \brief Determines if this Object is in its parent's list of children
+  ///        Objects with a parent that aren't listed yet are still being set up by whoever created them
+  bool _attached : 1;
+  /// \brief Determines if the children are updated in parallel
+  bool _parallel : 1;
+  /// \brief Determines if _transform was made by CreateTransform and must be deleted with this Object
+  bool _ownsTransform : 1;
+  /// \brief Determines if this Object's operator() updates its children itself
+  ///        Otherwise the update pass this Object is in updates its children once its operator() returns
+  ///        Set by CreateChild and AddChild for types whose operator() isn't known to leave the children to the pass
+  ///        (see LeavesChildrenToPass), and by built-in classes whose operator() only updates some of their children
+  bool _updatesOwnChildren : 1;
+  /// \brief Determines if this Object draws itself in its operator()
+  ///        Drawing Objects still have their operator() run while asleep so they stay on screen
+  ///        Derived classes that draw must set this in their constructors
+  bool _draws : 1;
+  /// \brief Determines if the Object is asleep (see Sleep)
+  bool _sleeping : 1;
+  /// \brief Determines if the Object falls asleep on its own after SleepDelay idle frames
+  bool _autoSleep : 1;
+  /// \brief PHASES flags for the hooks this Object takes part in
+  unsigned char _phases : 5;
+  /// \brief Determines if any children have ended since the last DestroyEnded
+  ///        Set when the Object is queued for compaction
+  ///        Kept out of the packed flags above since children ending in parallel update jobs set it from other threads
+  bool _hasEndedChildren;
+  /// \brief Number of frames between updates set on this Object
+  ///        0 if the interval is inherited from the parent
+  unsigned char _updateInterval;
+  /// \brief Frame within _updateInterval this Object is updated on
+  unsigned char _updateOffset;
+  /// \brief Cached interval of the update rate group this Object is in
+  ///        _updateInterval if it's set, otherwise the parent's
+  unsigned char _rateInterval;
+  /// \brief Cached offset of the update rate group this Object is in
+  unsigned char _rateOffset;
+  /// \brief Number of frames since the Object was last woken
+  ///        Only counted while _autoSleep is set
+  unsigned char _idleFrames;
 
-  /// \brief First child Transform::Transform
+  /// \brief Transform of this Object
+  ///        Either a member of a derived class or made by CreateTransform
   Transform::Transform *_transform;
   /// \brief First child Physics::Collider
   Physics::Collider *_collider;
@@ -60,6 +315,63 @@ protected:
   /// \brief Sets _parent to the given Object
   ///        Used by AddChild, CreateChild, etc.
   void SetParent(Object *parent);
+  /// \brief Recalculates _activeInTree from _valid, _active, and the parent
+  ///        Descendants are only recalculated if the result changed
+  ///        Called whenever _valid, _active, or _parent changes
+  void RefreshActive();
+  /// \brief Recalculates _rateInterval and _rateOffset from _updateInterval and the parent
+  ///        Descendants are only recalculated if the result changed
+  ///        Called whenever _updateInterval or _parent changes
+  void RefreshUpdateRate();
+  /// \brief Queues this Object to have its ended children removed by DestroyEnded
+  ///        Called by a child's End
+  void QueueEndedChild();
+  /// \brief Defers End until the current parallel update has finished
+  ///        Called at the start of End so derived End functions, which may touch shared state, don't run in jobs
+  /// \return True if End was deferred and the caller should return
+  bool DeferEnd();
+  /// \brief Removes every ended child from _children in a single stable pass
+  /// \param ended List to add the removed children to so they can be deleted together
+  void CompactChildren(std::vector<Object *> &ended);
+  /// \brief Gets the list of attached Objects taking part in a phase
+  /// \param phase PHASES::EARLY_UPDATE or PHASES::LATE_UPDATE
+  /// \return Phase list
+  static PhaseList &GetPhaseList(unsigned phase);
+  /// \brief Adds or removes this Object from the phase lists to match _phases and _attached
+  void UpdatePhaseLists();
+  /// \brief Updates every child as a job on the Jobs thread pool and waits for them
+  ///        Work each job defers with Defer is run afterwards in the order of the children
+  void UpdateChildrenInParallel();
+  /// \brief Updates this Object, then its descendants in a single pre-order pass
+  ///        Descendants are listed in cache, which is rebuilt if the tree has changed since it was last used
+  ///        If the tree changes partway through, the rest of the pass walks the tree itself
+  ///        Descendants updating their own children (see UpdatesOwnChildren) update the rest of their subtree themselves
+  ///        Used by operator() and Engine::Engine
+  /// \param cache List of descendants kept between frames
+  ///              nullptr walks the tree every time
+  void UpdateTree(TraversalCache *cache);
+  /// \brief Updates this Object's descendants in pre-order without recursing
+  /// \param cache List of descendants kept between frames
+  ///              nullptr walks the tree every time
+  void UpdateDescendants(TraversalCache *cache);
+  /// \brief Lists this Object's active descendants in pre-order
+  ///        Descendants of Objects updating their own children aren't listed
+  /// \param cache List to fill out
+  void BuildTraversal(TraversalCache &cache);
+  /// \brief Determines if update passes skip this Object's operator()
+  /// \return True if the Object is asleep and doesn't draw
+  bool SkippedWhileAsleep() const;
+  /// \brief Runs an Object's operator() as part of an update pass
+  /// \param o Object to update
+  /// \return True if the pass should update o's children
+  static bool UpdateInPass(Object *o);
+  /// \brief Walks the live tree from the frames on this thread's pass stack above base until it's back down to base
+  /// \param base Size of the pass stack to stop at
+  static void WalkPass(std::size_t base);
+  /// \brief Determines if the parallel update job running on this thread may change this Object directly
+  /// \return True if there is no job, this is in the job's subtree, or this isn't in the tree being updated
+  ///         False if this is shared with other jobs
+  bool OwnedByCurrentJob() const;
   /// \brief Runs OnStart if the object is currently active for the first time
   void TriggerOnStart();
   /// \brief Runs OnActivate if the object is currently active
@@ -67,7 +379,19 @@ protected:
   /// \brief Runs OnDeactivate if the object is currently active (being deactivated)
   void TriggerOnDeactivate();
 
+  /// \brief Clone constructor
+  ///        Copies other's name and settings (activity, phases, update interval, sleeping, etc.) and its Transform if it owns one
+  ///        The copy has no children and hasn't been started
+  ///        Derived classes overriding Clone should call this in their clone constructors' initialization list
+  /// \param other Object to copy
+  /// \param parent Parent Object creating the copy
+  Object(const Object &other, Object *parent);
+
 public:
+  /// \brief Class whose operator() leaves the children to the update pass (see LeavesChildrenToPass)
+  ///        Derived classes whose operator() only calls Object::operator() as its last step declare this as themselves
+  typedef Object PassUpdatedClass;
+
   /// \brief Constructor
   ///        Derived classes should call this in their constructors' initialization list
   /// \param parent Parent Object creating this Object
@@ -78,6 +402,41 @@ public:
   ///        This will End and then delete all child Objects
   virtual ~Object();
 
+  /// \brief Allocates memory for an Object from a slab pool
+  ///        Every Object created with new (CreateChild, AddChild(new ...), etc.) comes from here
+  ///        Objects of the same size share a pool, so each type sits contiguously in its pool's slabs
+  ///        Sizes larger than MAX_POOLED_SIZE fall back to the global operator new
+  /// \param size Size of the Object being created
+  /// \return Memory for the Object
+  static void *operator new(std::size_t size);
+  /// \brief Returns an Object's memory to the slab pool it came from
+  ///        Freed slots are reused by the next Object of the same size
+  /// \param p Memory of the Object being deleted
+  /// \param size Size of the Object being deleted
+  static void operator delete(void *p, std::size_t size);
+  /// \brief Largest Object size that's allocated from a slab pool
+  static const std::size_t MAX_POOLED_SIZE = 2048;
+  /// \brief Gets the number of Objects currently allocated from slab pools
+  /// \return Number of pooled Objects
+  static unsigned PooledCount();
+  /// \brief Gets the number of bytes reserved by slab pools
+  ///        Slabs are kept once reserved so later Objects can reuse them
+  /// \return Number of bytes in all slabs
+  static std::size_t PooledBytes();
+
+  /// \brief Gets the index of this Object's slot in the handle table
+  ///        Used by Handle
+  /// \return _handleSlot
+  unsigned HandleSlot() const;
+  /// \brief Gets the current generation of this Object's slot in the handle table
+  ///        Used by Handle
+  /// \return Slot generation
+  unsigned HandleGeneration() const;
+  /// \brief Gets a handle to this Object
+  ///        Use Handle<T>(object) for a handle of a derived type
+  /// \return Handle to this Object
+  Handle<Object> GetHandle();
+
   /// \brief Gets the parent of this Object
   /// \return _parent
   const Object *Parent() const;
@@ -91,12 +450,19 @@ public:
   /// \return Root Object of this Object's tree
   Object *Root();
 
-  /// \brief Gets the first child Transform::Transform
-  /// \return Child Transform
+  /// \brief Gets this Object's Transform
+  /// \return Transform
+  ///         nullptr if the Object doesn't have a position
   Transform::Transform *GetTransform();
-  /// \brief Gets the first child Transform::Transform
-  /// \return Child Transform
+  /// \brief Gets this Object's Transform
+  /// \return Transform
+  ///         nullptr if the Object doesn't have a position
   const Transform::Transform *GetTransform() const;
+  /// \brief Gives this Object a Transform if it doesn't already have one
+  ///        Geometry, Sprite, Text, Camera, Animation, Button and Collider have their own already
+  ///        The Transform is deleted with this Object
+  /// \return This Object's Transform
+  Transform::Transform *CreateTransform();
   /// \brief Gets the first child Physics::Collider
   /// \return Child Collider
   Physics::Collider *GetCollider();
@@ -113,16 +479,34 @@ public:
   /// \brief Updates this object and all of its children
   ///        Derived classes should call or reimplement this at some point in their operator()
   ///        This won't run if the Object isn't Active
+  ///        Descendants are updated in a single pre-order pass over the whole subtree (see UpdateTree),
+  ///        so an Object's children may be updated after its operator() returns instead of during Object::operator()
+  ///        Only classes that declare PassUpdatedClass are left to the pass; any other override of this updates its
+  ///        children during Object::operator() as before (see LeavesChildrenToPass)
   virtual void operator()();
 
   /// \brief Adds child to this Object's list of children
   ///        This will also set child's _parent to this
   ///        This will do nothing if child is already in the list of children
+  ///        During a parallel update, adding to an Object outside the calling job's subtree is deferred (see Defer)
   ///        Useful for adding an already created Object as a child or passing in the return operator new with parameters
   /// \param child Object to add to list of children
   void AddChild(Object *child);
+  /// \brief Adds child to this Object's list of children
+  ///        Children whose type overrides operator() without declaring PassUpdatedClass update their own children
+  ///        Objects added through an Object pointer can't be checked, so they must call UpdatesOwnChildren(true) themselves
+  /// \tparam T Type of child
+  /// \param child Object to add to list of children
+  template <typename T>
+  void AddChild(T *child)
+  {
+    if (child && !LeavesChildrenToPass<T>())
+      child->UpdatesOwnChildren(true);
+    AddChild(static_cast<Object *>(child));
+  }
   /// \brief Creates a new child of type T
   ///        Useful for creating an object with no constructor parameters and/or modifying it later
+  ///        The child is allocated from the slab pool for its size (see operator new)
   /// \tparam T Type of child to create
   ///           Must inherit Object
   /// \return Newly created Object
@@ -130,11 +514,13 @@ public:
   T *CreateChild()
   {
     T *o = new T(this);
-    AddChild(o);
+    o->Phases(PhasesOf<T>());
+    AddChild<T>(o);
     return o;
   }
   /// \brief Creates a new child of type T
   ///        Useful for creating an object with no constructor parameters and/or modifying it later
+  ///        The child is allocated from the slab pool for its size (see operator new)
   /// \tparam T Type of child to create
   ///           Must inherit Object
   /// \param name Name of the new object
@@ -143,9 +529,27 @@ public:
   T *CreateChild(std::string name)
   {
     T *o = new T(this, name);
-    AddChild(o);
+    o->Phases(PhasesOf<T>());
+    AddChild<T>(o);
     return o;
   }
+  /// \brief Creates a copy of this Object without its children
+  ///        Derived classes that can be copied override this to create themselves with their clone constructor
+  ///        Loaded assets, such as a Sprite's Texture, are shared with the copy instead of being loaded again
+  ///        The copy still has to be added to parent's children (see AddChild and CloneTree)
+  /// \param parent Parent Object creating the copy
+  /// \return Copy allocated from the slab pool for its size (see operator new)
+  ///         nullptr if the Object's type doesn't override Clone
+  virtual Object *Clone(Object *parent = nullptr) const;
+  /// \brief Creates a copy of this Object and all of its valid descendants
+  ///        The subtree is copied in a single pass without recursing, and each copy is added to its parent's copy
+  ///        so their GetCollider and GetRigidbody point to their own copied children
+  ///        Descendants whose type can't be cloned are left out along with their children
+  /// \param parent Object to add the copy to as a child
+  ///               nullptr leaves the copy without a parent
+  /// \return Copy of this Object
+  ///         nullptr if this Object's type can't be cloned
+  Object *CloneTree(Object *parent = nullptr) const;
   /// \brief Removes child from this Object's list of children
   ///        This will also set child's _parent to nullptr
   ///        This will do nothing if child is not in the Object's list of children
@@ -252,6 +656,7 @@ public:
     return vec;
   }
   /// \brief Recursively finds all descendent Objects of a type applicable to that which was requested
+  ///        Collects into a single vector with ForEachDescendantOfType
   /// \tparam T Type of descendent to find
   ///           Must inherit Object
   /// \return All children of type T
@@ -260,17 +665,10 @@ public:
   template <typename T>
   const std::vector<T *> FindDescendentsOfType() const
   {
-    std::vector<T *> vec;
-    for (unsigned i = 0; i < _children.size(); ++i)
-    {
-      if (dynamic_cast<T *>(_children[i]))
-        vec.push_back(dynamic_cast<T *>(_children[i]));
-      std::vector<T *> cvec = _children[i]->FindDescendentsOfType<T>();
-      vec.insert(vec.end(), cvec.begin(), cvec.end());
-    }
-    return vec;
+    return const_cast<Object *>(this)->FindDescendentsOfType<T>();
   }
   /// \brief Recursively finds all descendent Objects of a type applicable to that which was requested
+  ///        Collects into a single vector with ForEachDescendantOfType
   /// \tparam T Type of descendent to find
   ///           Must inherit Object
   /// \return All children of type T
@@ -280,21 +678,97 @@ public:
   std::vector<T *> FindDescendentsOfType()
   {
     std::vector<T *> vec;
+    ForEachDescendantOfType<T>([&vec](T *o) { vec.push_back(o); });
+    return vec;
+  }
+
+  /// \brief Calls fn on every child Object of a type applicable to that which was requested
+  ///        Children are visited in place, so nothing is allocated
+  /// \tparam T Type of children to visit
+  ///           Must inherit Object
+  /// \tparam F Function taking a T *
+  ///           If it returns bool, returning false stops the visit
+  /// \param fn Function to call on each child of type T
+  /// \return False if fn stopped the visit
+  template <typename T, typename F>
+  bool ForEachChildOfType(F &&fn)
+  {
     for (unsigned i = 0; i < _children.size(); ++i)
     {
-      if (dynamic_cast<T *>(_children[i]))
-        vec.push_back(dynamic_cast<T *>(_children[i]));
-      std::vector<T *> cvec = _children[i]->FindDescendentsOfType<T>();
-      vec.insert(vec.end(), cvec.begin(), cvec.end());
+      T *o = dynamic_cast<T *>(_children[i]);
+      if (o && !ContinueVisit(fn, o, 0))
+        return false;
     }
-    return vec;
+    return true;
+  }
+  /// \brief Calls fn on every child Object of a type applicable to that which was requested
+  ///        Children are visited in place, so nothing is allocated
+  /// \tparam T Type of children to visit
+  ///           Must inherit Object
+  /// \tparam F Function taking a const T *
+  ///           If it returns bool, returning false stops the visit
+  /// \param fn Function to call on each child of type T
+  /// \return False if fn stopped the visit
+  template <typename T, typename F>
+  bool ForEachChildOfType(F &&fn) const
+  {
+    for (unsigned i = 0; i < _children.size(); ++i)
+    {
+      const T *o = dynamic_cast<const T *>(_children[i]);
+      if (o && !ContinueVisit(fn, o, 0))
+        return false;
+    }
+    return true;
+  }
+  /// \brief Recursively calls fn on every descendent Object of a type applicable to that which was requested
+  ///        Descendents are visited in place in the same order as FindDescendentsOfType, so nothing is allocated
+  /// \tparam T Type of descendents to visit
+  ///           Must inherit Object
+  /// \tparam F Function taking a T *
+  ///           If it returns bool, returning false stops the visit
+  /// \param fn Function to call on each descendent of type T
+  /// \return False if fn stopped the visit
+  template <typename T, typename F>
+  bool ForEachDescendantOfType(F &&fn)
+  {
+    for (unsigned i = 0; i < _children.size(); ++i)
+    {
+      T *o = dynamic_cast<T *>(_children[i]);
+      if (o && !ContinueVisit(fn, o, 0))
+        return false;
+      if (!_children[i]->ForEachDescendantOfType<T>(fn))
+        return false;
+    }
+    return true;
+  }
+  /// \brief Recursively calls fn on every descendent Object of a type applicable to that which was requested
+  ///        Descendents are visited in place in the same order as FindDescendentsOfType, so nothing is allocated
+  /// \tparam T Type of descendents to visit
+  ///           Must inherit Object
+  /// \tparam F Function taking a const T *
+  ///           If it returns bool, returning false stops the visit
+  /// \param fn Function to call on each descendent of type T
+  /// \return False if fn stopped the visit
+  template <typename T, typename F>
+  bool ForEachDescendantOfType(F &&fn) const
+  {
+    for (unsigned i = 0; i < _children.size(); ++i)
+    {
+      const T *o = dynamic_cast<const T *>(_children[i]);
+      if (o && !ContinueVisit(fn, o, 0))
+        return false;
+      if (!static_cast<const Object *>(_children[i])->ForEachDescendantOfType<T>(fn))
+        return false;
+    }
+    return true;
   }
 
   /// \brief Determines if the Object is valid
-  /// \return Const reference to _valid
-  const bool &Valid() const;
+  /// \return _valid
+  bool Valid() const;
   /// \brief Determines if the Object is active
-  /// \return True if both valid and active
+  ///        Uses a cached flag, so this doesn't depend on the depth of the tree
+  /// \return True if this Object and all of its ancestors are both valid and active
   ///         False otherwise
   bool Active() const;
   /// \brief Sets active status of the object
@@ -317,8 +791,165 @@ public:
   ///        ```
   operator bool() const;
   /// \brief Shuts down and invalidates Object and all of its children
-  ///        An invalid child Object will be deleted by their parent after they update
+  ///        An invalid child Object is deleted by the next DestroyEnded
+  ///        During a parallel update, ending is deferred until the jobs have finished (see Defer),
+  ///        so the Object stays valid and End runs on the thread that started the update
+  ///        Derived classes overriding this should start with `if (DeferEnd()) return;`
   virtual void End();
+  /// \brief Removes ended Objects from their parents and deletes them
+  ///        Each parent with ended children has _children compacted once, then all the ended Objects are deleted together
+  ///        Run at the end of every Engine frame and after updating an Object with no parent
+  ///        Objects ended while this runs are also destroyed
+  static void DestroyEnded();
+
+  /// \brief Gets the phases this Object's hooks take part in
+  /// \return PHASES flags
+  unsigned Phases() const;
+  /// \brief Sets the phases this Object's hooks take part in
+  ///        Hooks for other phases aren't called
+  ///        Objects start in PHASES::ALL, and CreateChild narrows it to the hooks their type overrides
+  /// \param phases PHASES flags
+  void Phases(unsigned phases);
+  /// \brief Determines which hooks T overrides
+  ///        Hooks T can't be checked for (such as private overrides) are assumed to be overridden
+  /// \tparam T Type of Object to check
+  /// \return PHASES flags for every hook T overrides
+  template <typename T>
+  static unsigned PhasesOf()
+  {
+    unsigned phases = PHASES::NONE;
+    if (!InheritsOnEarlyUpdate<T>(0))
+      phases |= PHASES::EARLY_UPDATE;
+    if (!InheritsOnUpdate<T>(0))
+      phases |= PHASES::UPDATE;
+    if (!InheritsOnLateUpdate<T>(0))
+      phases |= PHASES::LATE_UPDATE;
+    if (!InheritsOnCollision<T>(0))
+      phases |= PHASES::COLLISION;
+    if (!InheritsOnMouseEnter<T>(0) || !InheritsOnMouseOver<T>(0) || !InheritsOnMouseExit<T>(0) ||
+        !InheritsOnMouseClick<T>(0) || !InheritsOnMouseRelease<T>(0))
+      phases |= PHASES::MOUSE;
+    return phases;
+  }
+  /// \brief Determines if T's operator() leaves the children to the update pass
+  ///        True if T inherits operator() from Object, or from a class that declares itself as PassUpdatedClass
+  ///        Overrides that can't be checked (such as private ones) are assumed to update their own children
+  /// \tparam T Type of Object to check
+  /// \return True if T's children can be updated by the pass T is in
+  template <typename T>
+  static constexpr bool LeavesChildrenToPass()
+  {
+    return OperatorLeavesChildrenToPass<T>(0);
+  }
+  /// \brief Calls the hook for phase on every active, attached descendant that takes part in it
+  ///        Called by Engine::Engine each frame
+  ///        Descendants are visited in tree pre-order, so parents run before their children
+  ///        The phase's list is put back in order first if anything was attached or removed since it was last run
+  ///        Sorting also caches the root of each listed Object, so checking it is under this Object is a pointer comparison
+  /// \param phase PHASES::EARLY_UPDATE or PHASES::LATE_UPDATE
+  void RunPhase(unsigned phase);
+
+  /// \brief Largest number of frames allowed between updates
+  static const unsigned MAX_UPDATE_INTERVAL = 255;
+  /// \brief Gets the number of frames between updates of this Object
+  /// \return Interval of the update rate group this Object is in
+  ///         1 if it's updated every frame
+  unsigned UpdateInterval() const;
+  /// \brief Puts this Object and every descendant without an interval of its own in an update rate group
+  ///        Objects in a group with an interval of N only run OnEarlyUpdate, OnUpdate, OnLateUpdate,
+  ///        and their own simulation (Rigidbody, Animation, controllers) every Nth frame
+  ///        They're still visited every frame so anything they draw stays on screen
+  ///        Groups with the same interval are given offsets in turn so their updates are spread across frames
+  /// \param interval Number of frames between updates, up to MAX_UPDATE_INTERVAL
+  ///                 1 updates every frame
+  ///                 0 goes back to the parent's interval
+  void UpdateInterval(unsigned interval);
+  /// \brief Gets the frame within the interval this Object is updated on
+  /// \return Offset of the update rate group this Object is in
+  unsigned UpdateOffset() const;
+  /// \brief Determines if this Object's update rate group is updated this frame
+  /// \return True if the Object should update this frame
+  bool UpdateDue() const;
+  /// \brief Determines if this Object's update rate group is updated on a given count of frames or ticks
+  ///        Used by Engine::Tick with Engine::Ticks so fixed timestep simulation follows the group too
+  /// \param count Number of frames or ticks
+  /// \return True if the Object should update on count
+  bool UpdateDue(unsigned long long count) const;
+  /// \brief Gets the time covered by this Object's update
+  ///        This is the total length of the last UpdateInterval frames,
+  ///        so Objects that skip frames still step by all of the time that passed
+  ///        Before the Engine counts its first frame, frames are assumed to be 1/60th of a second
+  /// \return Time in seconds
+  double UpdateDeltaTime() const;
+  /// \brief Counts a new frame for update rate groups
+  ///        Called by the main Engine::Engine at the start of each frame
+  /// \param deltaTime Length of the frame in seconds
+  static void AdvanceFrame(double deltaTime);
+  /// \brief Gets the number of frames counted by AdvanceFrame
+  /// \return Current frame
+  static unsigned long long Frame();
+
+  /// \brief Longest SleepDelay allowed
+  static const unsigned MAX_SLEEP_DELAY = 255;
+  /// \brief Determines if the Object is asleep
+  /// \return _sleeping
+  bool Sleeping() const;
+  /// \brief Puts the Object to sleep until it's woken
+  ///        Sleeping Objects don't run OnEarlyUpdate, OnUpdate, OnLateUpdate, or their own simulation
+  ///        (Rigidbody, Animation, controllers, Collider mouse testing), and update passes skip their operator()
+  ///        Objects that draw still have their operator() run so they stay on screen
+  ///        Children are still updated, and don't fall asleep with their parent
+  ///        Woken by Wake, by any change to their world transform, by colliding, or by the mouse moving over their Collider
+  void Sleep();
+  /// \brief Wakes the Object if it's asleep and restarts its count of idle frames
+  ///        Called whenever something changes the Object
+  void Wake();
+  /// \brief Determines if the Object falls asleep on its own
+  /// \return _autoSleep
+  bool AutoSleep() const;
+  /// \brief Sets if the Object falls asleep on its own after SleepDelay frames without being woken
+  /// \param autoSleep True to fall asleep on its own
+  void AutoSleep(bool autoSleep);
+  /// \brief Gets the number of idle frames before Objects with AutoSleep fall asleep
+  /// \return Number of frames
+  static unsigned SleepDelay();
+  /// \brief Sets the number of idle frames before Objects with AutoSleep fall asleep
+  /// \param frames Number of frames, from 1 to MAX_SLEEP_DELAY
+  static void SleepDelay(unsigned frames);
+
+  /// \brief Determines if operator() updates the children itself instead of leaving them to the update pass
+  /// \return True if _updatesOwnChildren is set or the children are updated in parallel
+  bool UpdatesOwnChildren() const;
+  /// \brief Sets if operator() updates the children itself instead of leaving them to the update pass
+  ///        Set automatically by CreateChild and AddChild for types that override operator() (see LeavesChildrenToPass)
+  /// \param updatesOwnChildren True if operator() updates the children itself
+  void UpdatesOwnChildren(bool updatesOwnChildren);
+
+  /// \brief Determines if the children are updated in parallel
+  /// \return _parallel
+  bool Parallel() const;
+  /// \brief Sets if the children are updated in parallel
+  ///        Each child's operator() runs as a job on the Jobs thread pool
+  ///        Only set this if the children's subtrees don't change or read anything another child's subtree changes
+  ///        Drawing, and adding or ending Objects outside a child's subtree, are deferred until the children have finished
+  /// \param parallel True to update the children in parallel
+  void Parallel(bool parallel);
+  /// \brief Runs fn now, or after the current parallel update if called from one of its jobs
+  ///        Deferred functions run on the thread that started the outermost parallel update,
+  ///        in the order of the children that deferred them
+  /// \param fn Function to run
+  static void Defer(std::function<void()> fn);
+  /// \brief Determines if the calling thread is running a job of a parallel update
+  /// \return True if inside a parallel update job
+  static bool InParallelUpdate();
+  /// \brief Gets a number that changes whenever an attached Object anywhere is added, removed, ended, activated,
+  ///        deactivated, put to sleep, woken, or moved to another update rate group
+  ///        Lets systems keep lists of what to update and only rebuild them when this changes
+  /// \return Current tree version
+  static unsigned TreeVersion();
+  /// \brief Determines if a parallel update is running on any thread
+  /// \return True while any parallel update's jobs are running
+  static bool ParallelUpdateRunning();
 
   /// \brief Uses Log::Log to print the parent/children tree of this Object
   /// \param log Log::Log to use
@@ -329,14 +960,28 @@ public:
 
   /// \brief Gets the Object's name
   /// \return Object name
-  std::string Name() const;
+  ///         Shared with every other Object of the same name
+  const std::string &Name() const;
+  /// \brief Gets the ID of the Object's name
+  ///        Objects have the same name if and only if they have the same name ID
+  /// \return ID of the name in the name table
+  unsigned NameId() const;
+  /// \brief Adds a name to the name table if it isn't there yet
+  ///        Names are kept for the rest of the program, so avoid making a new one for every Object
+  /// \param name Name to add
+  /// \return ID of the name
+  static unsigned InternName(const std::string &name);
+  /// \brief Gets a name from the name table
+  /// \param id ID of the name
+  /// \return Name with the given ID
+  static const std::string &NameOf(unsigned id);
 
   /// \brief Determines the number of immediate children the Object has
   /// \return Number of children owned by the Object
   unsigned ChildrenCount() const;
   /// \brief Gets the list of Objects that are children of this Object
   /// \return Children owned by the Object
-  std::vector<Object *> &Children();
+  ChildList &Children();
 
   /// \brief Determines if the provided Object is an ancestor of this Object
   /// \param other Potential ancestor of this Object
@@ -353,11 +998,19 @@ public:
   /// \brief Run when the Object is activated
   ///        Run after OnStart
   virtual void OnActivate();
-  /// \brief Run every frame
+  /// \brief Run every frame the Object's update rate group is due (see UpdateInterval)
   virtual void OnUpdate();
   /// \brief Run before OnUpdate
+  ///        Only run for attached Objects taking part in PHASES::EARLY_UPDATE (see RunPhase)
+  ///        and only on frames the Object's update rate group is due
+  ///        Object's version does nothing, and RunPhase reaches the children on its own,
+  ///        so overrides don't need to call it and calling this directly doesn't run the children's
   virtual void OnEarlyUpdate();
   /// \brief Run after OnUpdate
+  ///        Only run for attached Objects taking part in PHASES::LATE_UPDATE (see RunPhase)
+  ///        and only on frames the Object's update rate group is due
+  ///        Object's version does nothing, and RunPhase reaches the children on its own,
+  ///        so overrides don't need to call it and calling this directly doesn't run the children's
   virtual void OnLateUpdate();
   /// \brief Run when the Object is deactivated
   ///        Run before OnEnd
@@ -378,6 +1031,395 @@ public:
   virtual void OnMouseClick();
   /// \brief Run when the mouse is released while over the Object
   virtual void OnMouseRelease();
+
+private:
+  /// \brief Calls a visitor that doesn't return anything
+  ///        Used by the ForEach*OfType visitors
+  /// \return True so the visit continues
+  template <typename F, typename T>
+  static auto ContinueVisit(F &fn, T *o, int) -> typename std::enable_if<std::is_void<decltype(fn(o))>::value, bool>::type
+  {
+    fn(o);
+    return true;
+  }
+  /// \brief Calls a visitor that returns whether to keep visiting
+  ///        Used by the ForEach*OfType visitors
+  /// \return Result of fn
+  template <typename F, typename T>
+  static bool ContinueVisit(F &fn, T *o, ...)
+  {
+    return bool(fn(o));
+  }
+
+  /// \brief Declares a pair of functions that determine if T inherits a hook from Object unchanged
+  ///        The int overload is dropped when T's hook can't be named, which is treated as overridden
+#define ASPEN_OBJECT_INHERITS_HOOK(HOOK, ...)                                                       \
+  template <typename T>                                                                            \
+  static constexpr bool Inherits##HOOK(int, decltype(&T::HOOK) = nullptr)                           \
+  {                                                                                                \
+    return std::is_same<decltype(&T::HOOK), void (Object::*)(__VA_ARGS__)>::value;                 \
+  }                                                                                                \
+  template <typename T>                                                                            \
+  static constexpr bool Inherits##HOOK(...)                                                        \
+  {                                                                                                \
+    return false;                                                                                  \
+  }
+  ASPEN_OBJECT_INHERITS_HOOK(OnEarlyUpdate)
+  ASPEN_OBJECT_INHERITS_HOOK(OnUpdate)
+  ASPEN_OBJECT_INHERITS_HOOK(OnLateUpdate)
+  ASPEN_OBJECT_INHERITS_HOOK(OnCollision, Physics::Collision)
+  ASPEN_OBJECT_INHERITS_HOOK(OnMouseEnter)
+  ASPEN_OBJECT_INHERITS_HOOK(OnMouseOver)
+  ASPEN_OBJECT_INHERITS_HOOK(OnMouseExit)
+  ASPEN_OBJECT_INHERITS_HOOK(OnMouseClick)
+  ASPEN_OBJECT_INHERITS_HOOK(OnMouseRelease)
+#undef ASPEN_OBJECT_INHERITS_HOOK
+
+  /// \brief Names the class that declares a member function
+  ///        Only used in decltype
+  /// \tparam C Class the member function belongs to
+  /// \return Pointer to C
+  template <typename C>
+  static C *ClassOf(void (C::*)());
+  /// \brief Determines if the class declaring T's operator() declares itself as PassUpdatedClass
+  ///        The int overload is dropped when T's operator() can't be named, which is treated as updating its own children
+  template <typename T, typename C = typename std::remove_pointer<decltype(ClassOf(&T::operator()))>::type>
+  static constexpr bool OperatorLeavesChildrenToPass(int)
+  {
+    return std::is_same<typename C::PassUpdatedClass, C>::value;
+  }
+  template <typename T>
+  static constexpr bool OperatorLeavesChildrenToPass(...)
+  {
+    return false;
+  }
+};
+
+/// \brief Prefab class
+///        Captures a configured Object tree once so copies of it can be created quickly
+///        Instantiating copies the captured tree with Object::CloneTree instead of running constructors,
+///        so files aren't loaded again and names aren't looked up again for every copy
+class Prefab
+{
+  /// \brief Captured copy of the tree
+  ///        Kept without a parent so it's never updated
+  Object *_template;
+
+public:
+  /// \brief Constructor
+  ///        Copies original and its descendants, so original can be changed or ended afterwards
+  /// \param original Root of the tree to capture
+  explicit Prefab(const Object *original);
+  /// \brief Destructor
+  ///        Deletes the captured tree
+  ~Prefab();
+  /// \brief Copying is not allowed
+  Prefab(const Prefab &) = delete;
+  /// \brief Copying is not allowed
+  Prefab &operator=(const Prefab &) = delete;
+
+  /// \brief Determines if a tree was captured
+  /// \return True if original could be cloned
+  bool Valid() const;
+  /// \brief Gets the captured tree
+  ///        Changes to it are copied by later calls to Instantiate
+  /// \return Root of the captured tree
+  Object *Template();
+
+  /// \brief Creates a copy of the captured tree
+  /// \param parent Object to add the copy to as a child
+  ///               nullptr leaves the copy without a parent
+  /// \return Root of the copy
+  ///         nullptr if no tree was captured
+  Object *Instantiate(Object *parent = nullptr) const;
+  /// \brief Creates a copy of the captured tree
+  /// \tparam T Type of the captured root
+  /// \param parent Object to add the copy to as a child
+  ///               nullptr leaves the copy without a parent
+  /// \return Root of the copy as a T
+  ///         nullptr if no tree was captured or the root isn't a T
+  template <typename T>
+  T *Instantiate(Object *parent = nullptr) const
+  {
+    return dynamic_cast<T *>(Instantiate(parent));
+  }
+  /// \brief Creates many copies of the captured tree at once
+  ///        Room for all of them is made in parent's list of children up front
+  /// \param count Number of copies to create
+  /// \param parent Object to add the copies to as children
+  /// \return Roots of the copies
+  std::vector<Object *> Instantiate(unsigned count, Object *parent) const;
+};
+
+/// \brief Forward declaration
+template <typename T>
+class RegistryEntry;
+
+/// \brief Global list of every live instance of T
+///        Lets systems visit all Objects of a type without walking the Object tree
+///        Instances are listed in the order they were created
+/// \tparam T Type of Object listed
+///           Must inherit Object and hold a RegistryEntry<T>
+template <typename T>
+class Registry
+{
+  friend class RegistryEntry<T>;
+
+  /// \brief Storage shared by every Registry<T> function
+  ///        Kept in a function local static so Objects created during static initialization can register
+  class Storage
+  {
+  public:
+    /// \brief Registered instances
+    ///        Removed instances leave nullptr until the next compaction
+    std::vector<T *> instances;
+    /// \brief Entry of each registered instance at the same index
+    std::vector<RegistryEntry<T> *> entries;
+    /// \brief Number of nullptr slots in instances
+    unsigned holes = 0;
+    /// \brief Number of ForEach calls currently running
+    ///        Compaction is deferred until this is 0 so indices don't shift under a running ForEach
+    std::atomic<unsigned> iterating;
+    /// \brief Guards changes to the lists so Objects can be created and destroyed by parallel update jobs
+    std::mutex mutex;
+    /// \brief Incremented whenever an instance is added or removed
+    std::atomic<unsigned> version;
+
+    /// \brief Constructor
+    Storage()
+        : iterating(0), version(0)
+    {
+    }
+  };
+
+  /// \brief Active instances under a single Object, cached by Under
+  class Members
+  {
+  public:
+    /// \brief Object the instances are under
+    ///        nullptr if the cache has to be rebuilt
+    const Object *ancestor = nullptr;
+    /// \brief Object::TreeVersion the cache was built at
+    unsigned treeVersion = 0;
+    /// \brief Storage::version the cache was built at
+    unsigned registryVersion = 0;
+    /// \brief Cached instances in tree pre-order
+    std::vector<T *> instances;
+  };
+
+  /// \brief Gets the shared storage
+  /// \return Storage for this type
+  static Storage &GetStorage()
+  {
+    static Storage storage;
+    return storage;
+  }
+
+  /// \brief Adds an entry to the end of the list
+  /// \param entry Entry to add
+  static void Add(RegistryEntry<T> *entry)
+  {
+    Storage &s = GetStorage();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    entry->_index = unsigned(s.instances.size());
+    s.instances.push_back(entry->_object);
+    s.entries.push_back(entry);
+    ++s.version;
+  }
+
+  /// \brief Removes an entry from the list
+  ///        Does nothing if the entry isn't listed
+  /// \param entry Entry to remove
+  static void Remove(RegistryEntry<T> *entry)
+  {
+    Storage &s = GetStorage();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (entry->_index == NONE)
+      return;
+    s.instances[entry->_index] = nullptr;
+    s.entries[entry->_index] = nullptr;
+    entry->_index = NONE;
+    ++s.holes;
+    ++s.version;
+    if (s.iterating == 0 && s.holes * 2 > s.instances.size())
+      Compact();
+  }
+
+  /// \brief Removes every nullptr slot while keeping the remaining instances in order
+  ///        The caller must hold the storage's mutex
+  static void Compact()
+  {
+    Storage &s = GetStorage();
+    unsigned j = 0;
+    for (unsigned i = 0; i < s.instances.size(); ++i)
+    {
+      if (s.instances[i])
+      {
+        s.instances[j] = s.instances[i];
+        s.entries[j] = s.entries[i];
+        s.entries[j]->_index = j;
+        ++j;
+      }
+    }
+    s.instances.resize(j);
+    s.entries.resize(j);
+    s.holes = 0;
+  }
+
+  /// \brief Reads a slot of the lists
+  ///        While a parallel update is running, jobs may be adding and removing instances,
+  ///        so the slot is only read while holding the storage's mutex
+  /// \param i Index of the slot
+  /// \param o Set to the instance in the slot
+  /// \param entry Set to the entry in the slot
+  /// \return False if i is past the end of the lists
+  static bool ReadSlot(unsigned i, T *&o, RegistryEntry<T> *&entry)
+  {
+    Storage &s = GetStorage();
+    std::unique_lock<std::mutex> lock(s.mutex, std::defer_lock);
+    if (Object::ParallelUpdateRunning())
+      lock.lock();
+    if (i >= s.instances.size())
+      return false;
+    o = s.instances[i];
+    entry = s.entries[i];
+    return true;
+  }
+
+public:
+  /// \brief Index of an entry that isn't listed
+  static const unsigned NONE = 0xFFFFFFFF;
+
+  /// \brief Calls fn on every valid instance of T
+  ///        Instances found to be invalid (Ended) are removed as they're passed
+  ///        Instances created while this runs are also visited
+  ///        While a parallel update is running, the lists are read under a lock so jobs can add and remove instances,
+  ///        but like anything else a job reads, instances in other jobs' subtrees mustn't be changing
+  /// \tparam F Callable taking a T *
+  /// \param fn Function to call
+  template <typename F>
+  static void ForEach(F fn)
+  {
+    Storage &s = GetStorage();
+    ++s.iterating;
+    T *o;
+    RegistryEntry<T> *entry;
+    for (unsigned i = 0; ReadSlot(i, o, entry); ++i)
+    {
+      if (!o)
+        continue;
+      if (!o->Valid())
+      {
+        Remove(entry);
+        continue;
+      }
+      fn(o);
+    }
+    if (--s.iterating == 0)
+    {
+      std::lock_guard<std::mutex> lock(s.mutex);
+      if (s.iterating == 0 && s.holes > 0)
+        Compact();
+    }
+  }
+
+  /// \brief Gets every active instance under an Object in tree pre-order
+  ///        The list is cached and only rebuilt once the tree or this Registry changes,
+  ///        so systems can use it every frame without checking each instance's ancestors
+  ///        Only the last Object asked for is cached, and the list must only be used from the main thread
+  ///        Instances Ended since the list was built are still in it until the next rebuild
+  /// \param ancestor Object whose descendants are listed
+  /// \return Active instances under ancestor
+  static const std::vector<T *> &Under(Object *ancestor)
+  {
+    static Members members;
+    Storage &s = GetStorage();
+    if (members.ancestor == ancestor && members.treeVersion == Object::TreeVersion() && members.registryVersion == s.version)
+      return members.instances;
+    members.ancestor = ancestor;
+    members.treeVersion = Object::TreeVersion();
+    members.registryVersion = s.version;
+    members.instances.clear();
+    std::vector<const Object *> listed;
+    {
+      std::lock_guard<std::mutex> lock(s.mutex);
+      for (T *o : s.instances)
+        if (o)
+          listed.push_back(o);
+    }
+    if (listed.empty())
+      return members.instances;
+    std::sort(listed.begin(), listed.end());
+    // Walking the tree puts the instances in the same order a full update pass reaches them
+    std::vector<Object *> stack(1, ancestor);
+    while (!stack.empty())
+    {
+      Object *o = stack.back();
+      stack.pop_back();
+      if (o != ancestor && std::binary_search(listed.begin(), listed.end(), o))
+        members.instances.push_back(static_cast<T *>(o));
+      // Children are pushed in reverse so they're reached in order
+      ChildList &children = o->Children();
+      for (unsigned i = children.size(); i-- > 0;)
+        // Inactive Objects deactivate their whole subtree
+        if (children[i]->Active())
+          stack.push_back(children[i]);
+    }
+    return members.instances;
+  }
+
+  /// \brief Gets the number of listed instances
+  ///        Ended instances are counted until a ForEach passes them
+  /// \return Number of listed instances
+  static unsigned Count()
+  {
+    Storage &s = GetStorage();
+    return unsigned(s.instances.size()) - s.holes;
+  }
+};
+
+/// \brief Membership of a single Object in Registry<T>
+///        Classes that should be listed hold one of these as a member and construct it with `this`
+///        The Object is listed until it Ends or this is destroyed
+/// \tparam T Type of Object listed
+template <typename T>
+class RegistryEntry
+{
+  friend class Registry<T>;
+
+  /// \brief Object this entry lists
+  T *_object;
+  /// \brief Index of _object in the Registry
+  unsigned _index;
+
+public:
+  /// \brief Constructor
+  ///        Adds object to Registry<T>
+  /// \param object Object to list
+  explicit RegistryEntry(T *object)
+      : _object(object), _index(Registry<T>::NONE)
+  {
+    Registry<T>::Add(this);
+  }
+  /// \brief Copy constructor
+  ///        Copies of an Object aren't listed since the entry can't know which Object it now belongs to
+  RegistryEntry(const RegistryEntry &)
+      : _object(nullptr), _index(Registry<T>::NONE)
+  {
+  }
+  /// \brief Assignment operator
+  ///        Keeps this entry's own listing
+  /// \return *this
+  RegistryEntry &operator=(const RegistryEntry &)
+  {
+    return *this;
+  }
+  /// \brief Destructor
+  ///        Removes the Object from Registry<T>
+  ~RegistryEntry()
+  {
+    Registry<T>::Remove(this);
+  }
 };
 } // namespace Object
 } // namespace Aspen
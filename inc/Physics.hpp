@@ -1,13 +1,23 @@
 #ifndef __PHYSICS_HPP
 #define __PHYSICS_HPP
 #include "Object.hpp"
+#include "Transform.hpp"
 #include <string>
+#include <vector>
+#include <unordered_map>
 #define _USE_MATH_DEFINES
 #include <cmath>
 
 /// \brief Aspen engine namespace
 namespace Aspen
 {
+/// \brief Forward declaration
+namespace Engine
+{
+/// \brief Forward declaration
+class Engine;
+}; // namespace Engine
+
 /// \brief Physics namespace
 namespace Physics
 {
@@ -24,6 +34,31 @@ const double RIGHT = M_PI;
 const double UP = M_PI * 1.5;
 }; // namespace GRAV_DIR
 
+/// \brief Default side length of a broadphase grid cell
+extern const double DEFAULT_CELL_SIZE;
+/// \brief Most grid cells a single Collider may cover before it is tested against every other Collider instead
+extern const int MAX_PROXY_CELLS;
+
+/// \brief Forward declaration
+class Collider;
+/// \brief Forward declaration
+class RigidbodyBlock;
+
+/// \brief Broadphase entry for a single Collider
+class BroadphaseProxy
+{
+public:
+  /// \brief Collider this proxy represents
+  Collider *collider;
+  /// \brief True if the Collider reported finite bounds
+  ///        Unbounded Colliders are paired with every other Collider
+  bool bounded;
+  /// \brief World space bounds of the Collider
+  double left, top, right, bottom;
+  /// \brief Range of grid cells covered by the bounds
+  int x0, y0, x1, y1;
+};
+
 /// \brief Physics class
 class Physics : public Object::Object
 {
@@ -33,6 +68,26 @@ class Physics : public Object::Object
   double _gravDirection;
   /// \brief Drag factor
   double _drag;
+  /// \brief Side length of a broadphase grid cell
+  double _cellSize;
+  /// \brief Active Colliders in the Engine for the current step, in tree pre-order
+  ///        Kept between steps to avoid reallocating it
+  std::vector<Collider *> _colliders;
+  /// \brief Broadphase proxies for the current step
+  ///        Indices match the list of Colliders being tested
+  std::vector<BroadphaseProxy> _proxies;
+  /// \brief Spatial hash of grid cell to the indices of the proxies covering it
+  ///        Buckets are kept between steps to avoid reallocating them
+  std::unordered_map<long long, std::vector<unsigned>> _grid;
+  /// \brief Indices of proxies without usable bounds
+  std::vector<unsigned> _unbounded;
+  /// \brief Candidate pairs found by the broadphase
+  std::vector<std::pair<unsigned, unsigned>> _pairs;
+
+  /// \brief Fills _pairs with every pair of colliders whose bounds overlap
+  ///        Pairs are sorted so they are resolved in the same order as an all-pairs test
+  /// \param colliders Active Colliders to test
+  void FindPairs(const std::vector<Collider *> &colliders);
 
 public:
   /// \brief Constructor
@@ -64,6 +119,20 @@ public:
   ///        Derived classes should call or reimplement this at some point in their operator()
   ///        This won't run if the Object isn't Active
   void operator()();
+  /// \brief Finds and resolves collisions between every active Collider under the Engine
+  ///        Pairs are resolved in tree pre-order of their Colliders, so results don't depend on creation order
+  ///        Called by operator(), or by Engine::Engine::Tick while the Engine has a fixed timestep
+  void Step();
+  /// \brief Steps every Rigidbody under engine that is due this tick
+  ///        Rigidbody values are packed into arrays, so the integration is a single linear pass over them
+  ///        Which slots are stepped is cached and only worked out again when Object::TreeVersion changes
+  ///        Called by Engine::Engine::Tick while the Engine has a fixed timestep
+  /// \param engine Engine being ticked
+  void Integrate(Engine::Engine *engine);
+  /// \brief Wakes sleeping Colliders under the Engine that the mouse moved onto or clicked
+  ///        Sleeping Colliders don't test the mouse themselves
+  ///        Called by operator()
+  void WakeHovered();
 
   /// \brief Gets the current gravity strength
   /// \return Gravity strength
@@ -95,26 +164,37 @@ public:
   /// \param drag New drag factor
   void SetDrag(double drag);
 
+  /// \brief Gets the side length of a broadphase grid cell
+  /// \return _cellSize
+  double GetCellSize();
+  /// \brief Sets the side length of a broadphase grid cell
+  ///        Works best around the size of a typical Collider
+  /// \param size New cell size
+  ///             Values <= 0 are ignored
+  void SetCellSize(double size);
+
   /// \brief Fills out the Debugger if it exists with this Object's information
   ///        Derived classes should call their base class's version of this method
   void PopulateDebugger();
 };
 
 /// \brief Rigidbody class
+///        Its mass, velocity, acceleration and gravity scale are stored in a RigidbodyBlock so Physics::Integrate can step every Rigidbody in one pass
 class Rigidbody : public Object::Object
 {
-  /// \brief Mass of the object
-  double _mass;
-  /// \brief Strength of velocity
-  double _velocityStrength;
-  /// \brief Direction of velocity
-  double _velocityDirection;
-  /// \brief Strength of acceleration
-  double _accelerationStrength;
-  /// \brief Direction of acceleration
-  double _accelerationDirection;
-  /// \brief Amount gravity affects this object
-  double _gravityScale;
+  /// \brief Block holding this Rigidbody's values
+  RigidbodyBlock *_block;
+  /// \brief Index of this Rigidbody's values in _block
+  unsigned _slot;
+  /// \brief Lists this in Aspen::Object::Registry<Rigidbody>
+  Aspen::Object::RegistryEntry<Rigidbody> _registryEntry;
+
+protected:
+  /// \brief Clone constructor
+  ///        Used by Clone
+  /// \param other Rigidbody to copy
+  /// \param parent Parent Object creating the copy
+  Rigidbody(const Rigidbody &other, Object *parent);
 
 public:
   /// \brief Constructor
@@ -132,10 +212,22 @@ public:
   /// \brief Destructor
   ~Rigidbody();
 
+  /// \brief Creates a copy of this Object without its children
+  /// \param parent Parent Object creating the copy
+  /// \return Copy of this Object
+  Object *Clone(Object *parent = nullptr) const;
+
+  /// \brief This class's operator() leaves the children to the update pass (see Object::LeavesChildrenToPass)
+  typedef Rigidbody PassUpdatedClass;
+
   /// \brief Updates this object and all of its children
   ///        Derived classes should call or reimplement this at some point in their operator()
   ///        This won't run if the Object isn't Active
   void operator()();
+  /// \brief Applies gravity, drag and acceleration and moves the parent's Transform
+  ///        Called by operator(), or by Engine::Engine::Tick while the Engine has a fixed timestep
+  /// \param dt Time to simulate in 60ths of a second
+  void Step(double dt);
 
   /// \brief Gets the object's mass
   /// \return Object's mass
@@ -229,6 +321,17 @@ protected:
   bool _trigger;
   /// \brief Determines if the collider is being moused over
   bool _mouseOver;
+  /// \brief Lists this in Aspen::Object::Registry<Collider>
+  Aspen::Object::RegistryEntry<Collider> _registryEntry;
+  /// \brief Position, rotation and scale of this Object
+  ///        Returned by GetTransform
+  Aspen::Transform::Transform _transformComponent;
+
+  /// \brief Clone constructor
+  ///        Used by Clone
+  /// \param other Collider to copy
+  /// \param parent Parent Object creating the copy
+  Collider(const Collider &other, Object *parent);
 
 public:
   /// \brief Constructor
@@ -238,6 +341,14 @@ public:
   ///             Set by derived classes to a string representation of their type
   Collider(Object *parent = nullptr, std::string name = "Collider");
 
+  /// \brief Creates a copy of this Object without its children
+  /// \param parent Parent Object creating the copy
+  /// \return Copy of this Object
+  Object *Clone(Object *parent = nullptr) const;
+
+  /// \brief This class's operator() leaves the children to the update pass (see Object::LeavesChildrenToPass)
+  typedef Collider PassUpdatedClass;
+
   /// \brief Updates this object and all of its children
   ///        Derived classes should call or reimplement this at some point in their operator()
   ///        This won't run if the Object isn't Active
@@ -257,6 +368,15 @@ public:
   /// \return True if (x, y) is within the collider
   ///         False otherwise
   virtual bool InCollider(int x, int y);
+  /// \brief Gets the world space bounds used by the Physics broadphase
+  ///        Bounds must contain every point TestCollision could report a collision at
+  /// \param left Set to the left edge
+  /// \param top Set to the top edge
+  /// \param right Set to the right edge
+  /// \param bottom Set to the bottom edge
+  /// \return True if the bounds were set
+  ///         False if the Collider has no known bounds and must be tested against every other Collider
+  virtual bool GetBounds(double &left, double &top, double &right, double &bottom);
 
   /// \brief Determines if the collider is a trigger or solid object
   /// \return _trigger
@@ -276,6 +396,13 @@ class CircleCollider : public Collider
   /// \brief Radius of the collider
   double _radius;
 
+protected:
+  /// \brief Clone constructor
+  ///        Used by Clone
+  /// \param other CircleCollider to copy
+  /// \param parent Parent Object creating the copy
+  CircleCollider(const CircleCollider &other, Object *parent);
+
 public:
   /// \brief Constructor
   /// \param parent Parent Object to be passed to Object constructor
@@ -290,6 +417,11 @@ public:
   ///             Set by derived classes to a string representation of their type
   CircleCollider(double radius, Object *parent = nullptr, std::string name = "CircleCollider");
 
+  /// \brief Creates a copy of this Object without its children
+  /// \param parent Parent Object creating the copy
+  /// \return Copy of this Object
+  Object *Clone(Object *parent = nullptr) const;
+
   /// \brief Finds if there is a collision between this Collider and another Collider
   /// \param other Second collider
   /// \return Collisions found between the two objects
@@ -304,6 +436,13 @@ public:
   /// \return True if (x, y) is within the collider
   ///         False otherwise
   bool InCollider(int x, int y);
+  /// \brief Gets the world space bounds used by the Physics broadphase
+  /// \param left Set to the left edge
+  /// \param top Set to the top edge
+  /// \param right Set to the right edge
+  /// \param bottom Set to the bottom edge
+  /// \return True if the bounds were set
+  bool GetBounds(double &left, double &top, double &right, double &bottom);
 
   /// \brief Gets the radius
   /// \return _radius
@@ -325,6 +464,13 @@ class AABBCollider : public Collider
   /// \brief Height of the box
   double _height;
 
+protected:
+  /// \brief Clone constructor
+  ///        Used by Clone
+  /// \param other AABBCollider to copy
+  /// \param parent Parent Object creating the copy
+  AABBCollider(const AABBCollider &other, Object *parent);
+
 public:
   /// \brief Constructor
   /// \param parent Parent Object to be passed to Object constructor
@@ -340,6 +486,11 @@ public:
   ///             Set by derived classes to a string representation of their type
   AABBCollider(double width, double height, Object *parent = nullptr, std::string name = "AABBCollider");
 
+  /// \brief Creates a copy of this Object without its children
+  /// \param parent Parent Object creating the copy
+  /// \return Copy of this Object
+  Object *Clone(Object *parent = nullptr) const;
+
   /// \brief Finds if there is a collision between this Collider and another Collider
   /// \param other Second collider
   /// \return Collisions found between the two objects
@@ -354,6 +505,14 @@ public:
   /// \return True if (x, y) is within the collider
   ///         False otherwise
   bool InCollider(int x, int y);
+  /// \brief Gets the world space bounds used by the Physics broadphase
+  ///        Uses the box's half diagonal on both axes since that is the reach of its Circle test
+  /// \param left Set to the left edge
+  /// \param top Set to the top edge
+  /// \param right Set to the right edge
+  /// \param bottom Set to the bottom edge
+  /// \return True if the bounds were set
+  bool GetBounds(double &left, double &top, double &right, double &bottom);
 
   /// \brief Gets the width
   /// \return _width
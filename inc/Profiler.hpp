@@ -0,0 +1,73 @@
+#ifndef __PROFILER_HPP
+#define __PROFILER_HPP
+#include <string>
+
+/// \brief Aspen engine namespace
+namespace Aspen
+{
+/// \brief Profiler namespace
+///        Records scoped timing zones for finding out where a frame's time goes
+///        Zones are only recorded when compiled with __PROFILE defined (make PROFILE=1)
+namespace Profiler
+{
+/// \brief Number of zones each thread keeps before overwriting its oldest ones
+extern const unsigned RING_SIZE;
+/// \brief Longest zone name that is kept, including the terminating null
+const unsigned NAME_LENGTH = 48;
+
+/// \brief Times the scope it's declared in and records it when it ends
+///        Use the ASPEN_PROFILE_ZONE macro so it's compiled out without __PROFILE
+class ScopedZone
+{
+  /// \brief Name of the zone
+  ///        Copied so temporary names can be used
+  char _name[NAME_LENGTH];
+  /// \brief Time the zone started in nanoseconds since the profiler started
+  unsigned long long _start;
+
+public:
+  /// \brief Constructor
+  ///        Starts timing
+  /// \param name Name of the zone
+  ScopedZone(const char *name);
+  /// \brief Constructor
+  ///        Starts timing
+  /// \param name Name of the zone
+  ScopedZone(const std::string &name);
+  /// \brief Destructor
+  ///        Records the zone into this thread's ring buffer
+  ~ScopedZone();
+};
+
+/// \brief Starts a new frame
+///        Called by Engine::Engine at the start of each frame
+void NewFrame();
+/// \brief Gets the current frame
+/// \return Number of times NewFrame has been called
+unsigned long long Frame();
+
+/// \brief Writes recorded zones to a file as Chrome trace event JSON
+///        The file can be opened with chrome://tracing or any viewer that reads the format
+/// \param path Path of the file to write
+/// \param frames Number of most recent frames to write
+///               0 writes every zone still in the ring buffers
+/// \return True if the file was written
+bool WriteTrace(std::string path, unsigned frames = 0);
+} // namespace Profiler
+} // namespace Aspen
+
+#define ASPEN_PROFILE_CONCAT_INNER(a, b) a##b
+#define ASPEN_PROFILE_CONCAT(a, b) ASPEN_PROFILE_CONCAT_INNER(a, b)
+#ifdef __PROFILE
+/// \brief Times the rest of the enclosing scope as a zone with the given name
+#define ASPEN_PROFILE_ZONE(name) Aspen::Profiler::ScopedZone ASPEN_PROFILE_CONCAT(_profileZone, __LINE__)(name)
+/// \brief Starts a new profiler frame
+#define ASPEN_PROFILE_FRAME() Aspen::Profiler::NewFrame()
+#else
+/// \brief Times the rest of the enclosing scope as a zone with the given name
+#define ASPEN_PROFILE_ZONE(name)
+/// \brief Starts a new profiler frame
+#define ASPEN_PROFILE_FRAME()
+#endif
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef __SCENE_HPP
+#define __SCENE_HPP
+#include <cstdint>
+#include <string>
+#include "Object.hpp"
+
+/// \brief Aspen engine namespace
+namespace Aspen
+{
+/// \brief Scene namespace
+///        Saves and loads trees of Objects as compact binary scene files
+///        Files are memory-mapped and their records read in place, so loading is mostly creating the Objects
+namespace Scene
+{
+/// \brief Version of the scene format written by Save
+///        Load only reads files with this version
+const std::uint32_t VERSION = 1;
+/// \brief Index used as the parent of records whose parent is the Object the scene is loaded into
+const std::uint32_t ROOT = 0xFFFFFFFF;
+
+/// \brief Types of Object a scene record can hold
+///        Only Objects of exactly these types are saved, so derived classes must be created in code
+namespace TYPE
+{
+/// \brief Aspen::Object::Object
+const std::uint32_t OBJECT = 0;
+/// \brief Aspen::Graphics::Rectangle
+///        Params are x, y, width, and height
+const std::uint32_t RECTANGLE = 1;
+/// \brief Aspen::Graphics::Point
+///        Params are x and y
+const std::uint32_t POINT = 2;
+/// \brief Aspen::Graphics::Line
+///        Params are start x, start y, end x, end y, and center
+const std::uint32_t LINE = 3;
+/// \brief Aspen::Graphics::Sprite
+///        Uses the record's path
+const std::uint32_t SPRITE = 4;
+/// \brief Aspen::Physics::Rigidbody
+///        Params are mass and gravity scale
+///        Velocity and acceleration aren't saved, so loaded Rigidbodies start at rest
+const std::uint32_t RIGIDBODY = 5;
+/// \brief Aspen::Physics::CircleCollider
+///        Params are radius
+const std::uint32_t CIRCLE_COLLIDER = 6;
+/// \brief Aspen::Physics::AABBCollider
+///        Params are width and height
+const std::uint32_t AABB_COLLIDER = 7;
+/// \brief Number of types
+const std::uint32_t COUNT = 8;
+} // namespace TYPE
+
+/// \brief Flags of a scene record
+namespace RECORD_FLAGS
+{
+/// \brief No flags
+const std::uint32_t NONE = 0;
+/// \brief The Object has a Transform with the record's position, rotation, and scale
+const std::uint32_t TRANSFORM = 1 << 0;
+/// \brief The Geometry is filled
+const std::uint32_t FILL = 1 << 1;
+/// \brief The Collider is a trigger
+const std::uint32_t TRIGGER = 1 << 2;
+} // namespace RECORD_FLAGS
+
+/// \brief Start of a scene file
+///        Followed by objectCount Records and then stringBytes bytes of null-terminated strings
+///        Everything is stored in the machine's native (little endian) byte order
+class Header
+{
+public:
+  /// \brief Always "ASCN"
+  char magic[4];
+  /// \brief Version of the format the file was written with
+  std::uint32_t version;
+  /// \brief Number of Records
+  std::uint32_t objectCount;
+  /// \brief Size of the string table
+  std::uint32_t stringBytes;
+};
+
+/// \brief A single Object of a scene file
+///        Records are in pre-order, so a record's parent always comes before it
+class Record
+{
+public:
+  /// \brief TYPE of the Object
+  std::uint32_t type;
+  /// \brief Index of the parent's Record
+  ///        ROOT if the parent is the Object the scene is loaded into
+  std::uint32_t parent;
+  /// \brief Offset of the Object's name in the string table
+  std::uint32_t name;
+  /// \brief Offset of the Sprite's path in the string table
+  std::uint32_t path;
+  /// \brief Local x position
+  float x;
+  /// \brief Local y position
+  float y;
+  /// \brief Local rotation
+  float rotation;
+  /// \brief Local x scale
+  float xScale;
+  /// \brief Local y scale
+  float yScale;
+  /// \brief Color of Geometry packed as 0xRRGGBBAA
+  std::uint32_t color;
+  /// \brief RECORD_FLAGS
+  std::uint32_t flags;
+  /// \brief Parameters of the type (see TYPE)
+  float params[5];
+};
+
+/// \brief Saves every descendant of root into a scene file
+///        Descendants that aren't one of the TYPEs are left out along with their children
+/// \param root Object whose descendants are saved
+///             Isn't saved itself so the scene can be loaded into any Object
+/// \param path Path of the file to write
+/// \return True if the file was written
+bool Save(Object::Object *root, std::string path);
+/// \brief Loads a scene file and adds its Objects to parent
+///        The file is memory-mapped and read in place, and every Object's list of children is allocated once
+/// \param path Path of the file to load
+/// \param parent Object to add the scene's top level Objects to
+///        Nothing is added if any record is corrupt or its Object can't be created, like a Sprite whose image is missing
+/// \return True if the file was loaded
+bool Load(std::string path, Object::Object *parent);
+} // namespace Scene
+} // namespace Aspen
+
+#endif
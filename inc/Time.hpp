@@ -49,6 +49,9 @@ public:
   /// \return _main
   static Time *Get();
 
+  /// \brief This class's operator() leaves the children to the update pass (see Object::LeavesChildrenToPass)
+  typedef Time PassUpdatedClass;
+
   /// \brief Updates this object and all of its children
   ///        Derived classes should call or reimplement this at some point in their operator()
   ///        This won't run if the Object isn't Active
@@ -64,6 +67,8 @@ public:
   /// \return Start time of the current frame
   double CurrentTime();
   /// \brief Time since the last frame in seconds
+  ///        Time is still updated every frame when it's in an update rate group
+  ///        Objects that only update every few frames should use Object::UpdateDeltaTime instead
   /// \return Time since the last frame
   double DeltaTime();
   /// \brief Current framerate of the application
@@ -11,8 +11,13 @@ namespace Aspen
 namespace Transform
 {
 /// \brief Transform class
-class Transform : public Object::Object
+///        Lightweight component stored inline in the Object it belongs to and reached with Object::GetTransform
+///        World values are accumulated from the Transforms of the owner's ancestors
+///        The owner's own values are applied once, on top of the world values of the nearest Transform above the owner
+class Transform
 {
+  /// \brief Object this Transform belongs to
+  Object::Object *_owner;
   /// \brief X position
   float _posx;
   /// \brief Y position
@@ -23,14 +28,81 @@ class Transform : public Object::Object
   float _scalex;
   /// \brief Y scale
   float _scaley;
+  /// \brief Lists this in Aspen::Object::Registry<Transform>
+  Aspen::Object::RegistryEntry<Transform> _registryEntry;
+
+  /// \brief Position, rotation and scale accumulated from an Object up to the root
+  class Accumulated
+  {
+  public:
+    /// \brief Accumulated x position
+    double xPosition;
+    /// \brief Accumulated y position
+    double yPosition;
+    /// \brief Accumulated rotation
+    double rotation;
+    /// \brief Accumulated x scale
+    double xScale;
+    /// \brief Accumulated y scale
+    double yScale;
+  };
+  /// \brief World values of this Transform
+  ///        Only up to date while _dirty is false
+  mutable Accumulated _world;
+  /// \brief True if _world must be recalculated before it's used
+  ///        Every Transform below a dirty one is dirty too, since it was calculated through it
+  mutable bool _dirty;
+  /// \brief True if _previous has been saved
+  bool _hasPrevious;
+  /// \brief World values saved at the start of the last fixed tick
+  Accumulated _previous;
+  /// \brief How far world getters are blended from _previous to the current values
+  ///        1 returns the current values
+  static double _interpolation;
+  /// \brief Value _interpolation is set to while a DrawScope exists
+  static double _drawInterpolation;
+
+  /// \brief Gets the world values, recalculating them if they're out of date
+  /// \return _world
+  const Accumulated &World() const;
+  /// \brief Blends a saved world value toward the current one by _interpolation
+  /// \param previous Value saved by SaveState
+  /// \param current Current value
+  /// \return Blended value
+  static double Interpolate(double previous, double current);
+  /// \brief Gets the accumulated values of an Object
+  ///        Reads the world values of the nearest Transform at or above o
+  /// \param o Object to accumulate from
+  /// \return Accumulated values of o
+  static Accumulated Accumulate(const Object::Object *o);
 
 public:
   /// \brief Constructor
-  ///        Derived classes should call this in their constructors' initialization list
-  /// \param parent Parent Object creating this Object
-  /// \param name Object name
-  ///             Set by derived classes to a string representation of their type
-  Transform(Object *parent = nullptr, std::string name = "Transform");
+  ///        Becomes owner's Transform if it doesn't have one yet
+  ///        Classes with a position hold one of these as a member and construct it with `this`
+  /// \param owner Object this Transform belongs to
+  ///              nullptr makes a free-standing Transform with no parents
+  explicit Transform(Object::Object *owner = nullptr);
+  /// \brief Copy constructor
+  ///        Copies the local values into a free-standing Transform
+  /// \param other Transform to copy
+  Transform(const Transform &other);
+  /// \brief Assignment operator
+  ///        Copies the local values and keeps this Transform's owner
+  /// \param other Transform to copy
+  /// \return *this
+  Transform &operator=(const Transform &other);
+  /// \brief Destructor
+  ///        Stops being its owner's Transform
+  ~Transform();
+
+  /// \brief Gets the Object this Transform belongs to
+  /// \return _owner
+  Object::Object *Owner() const;
+  /// \brief Determines if the owner is still valid
+  ///        Used by Aspen::Object::Registry<Transform>
+  /// \return True if there is no owner or the owner is valid
+  bool Valid() const;
 
   /// \brief Sets the position
   /// \param x New x position
@@ -173,11 +245,95 @@ public:
   /// \return Result of the combination
   Transform &operator+=(const Transform &rhs);
 
-  /// \brief Fills out the Debugger if it exists with this Object's information
-  ///        Derived classes should call their base class's version of this method
+  /// \brief Saves the current world values to be interpolated from
+  ///        Called by Engine::Engine at the start of each fixed tick
+  void SaveState();
+  /// \brief Sets how far world getters are blended from the values saved by SaveState to the current values
+  ///        Usually only changed by DrawScope
+  /// \param alpha Blend amount in [0, 1]
+  ///              1 returns the current values
+  static void SetInterpolation(double alpha);
+  /// \brief Gets how far world getters are blended from the values saved by SaveState to the current values
+  /// \return _interpolation
+  static double GetInterpolation();
+  /// \brief Sets how far world getters are blended while drawing (see DrawScope)
+  ///        Set by Engine::Engine each frame to how far it is between two fixed ticks
+  /// \param alpha Blend amount in [0, 1]
+  ///              1 draws the current values
+  static void SetDrawInterpolation(double alpha);
+  /// \brief Gets how far world getters are blended while drawing
+  /// \return _drawInterpolation
+  static double GetDrawInterpolation();
+
+  /// \brief Blends world getters by the draw interpolation for as long as it exists
+  ///        Created by Graphics while it reads the Transforms of what it draws,
+  ///        so gameplay code always reads the current values
+  class DrawScope
+  {
+    /// \brief Interpolation to go back to
+    double _previous;
+
+  public:
+    /// \brief Constructor
+    ///        Sets the interpolation to the draw interpolation
+    DrawScope();
+    /// \brief Destructor
+    ///        Puts the interpolation back
+    ~DrawScope();
+  };
+
+  /// \brief Marks the cached world values of this and every Transform that depends on it as out of date
+  ///        Called by every Set and Modify function
+  ///        Wakes the owner and every descendant that moves with it (see Object::Sleep)
+  ///        Only the owner's children are woken if the cache was already out of date
+  void Invalidate();
+  /// \brief Marks the cached world values of every Transform under root as out of date
+  ///        Transforms of root's descendants are marked, but not root's own
+  ///        Wakes every descendant reached
+  /// \param root Object whose descendants are marked
+  static void InvalidateDescendants(Object::Object *root);
+  /// \brief Marks the cached world values of root's Transform and every Transform under it as out of date
+  ///        Called by Object::Object when root is given a new parent
+  ///        Wakes root and every descendant reached
+  /// \param root Object whose Transform and descendants are marked
+  static void InvalidateTree(Object::Object *root);
+  /// \brief Brings the cached world values of the Transforms at and above o up to date
+  ///        Called before o falls asleep so moving anything above it wakes it
+  /// \param o Object whose ancestors' caches are updated
+  static void UpdateCache(const Object::Object *o);
+  /// \brief Brings the cached world values of every Transform at, above and under root up to date
+  ///        Called before root's children are updated in parallel, so jobs reading world values anywhere in the tree
+  ///        don't fill in the same cache at once
+  ///        Only caches a job's own Objects make dirty again are filled in by that job
+  /// \param root Object whose subtree and ancestors' caches are updated
+  static void UpdateTreeCache(Object::Object *root);
+
+  /// \brief Fills out the Debugger if it exists with this Transform's information
+  ///        Called by Object::PopulateDebugger for the owner's Transform
   void PopulateDebugger();
 };
 } // namespace Transform
+
+namespace Object
+{
+/// \brief Gives this Object a Transform instead of creating a child
+///        Transforms aren't Objects, so this keeps CreateChild<Transform::Transform>() working
+/// \return This Object's Transform
+template <>
+inline Transform::Transform *Object::CreateChild<Transform::Transform>()
+{
+  return CreateTransform();
+}
+/// \brief Gives this Object a Transform instead of creating a child
+///        Transforms aren't Objects, so this keeps CreateChild<Transform::Transform>(name) working
+/// \param name Ignored
+/// \return This Object's Transform
+template <>
+inline Transform::Transform *Object::CreateChild<Transform::Transform>(std::string name)
+{
+  return CreateTransform();
+}
+} // namespace Object
 } // namespace Aspen
 
 #endif
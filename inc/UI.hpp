@@ -33,6 +33,16 @@ class Text : public Object::Object
   SDL_Rect _rect;
   /// \brief Size of text
   int _size;
+  /// \brief Position, rotation and scale of this Object
+  ///        Returned by GetTransform
+  Aspen::Transform::Transform _transformComponent;
+
+protected:
+  /// \brief Clone constructor
+  ///        Used by Clone
+  /// \param other Text to copy
+  /// \param parent Parent Object creating the copy
+  Text(const Text &other, Object *parent);
 
 public:
   /// \brief Constructor
@@ -68,6 +78,14 @@ public:
   /// \brief Destructor
   ~Text();
 
+  /// \brief Creates a copy of this Object without its children
+  /// \param parent Parent Object creating the copy
+  /// \return Copy of this Object
+  Object *Clone(Object *parent = nullptr) const;
+
+  /// \brief This class's operator() leaves the children to the update pass (see Object::LeavesChildrenToPass)
+  typedef Text PassUpdatedClass;
+
   /// \brief Draws the sprite to the parent Object's window if parent is of type Graphics
   void operator()();
 
@@ -104,6 +122,7 @@ public:
   void SetSize(int size);
 
   /// \brief Generates _tex
+  ///        Deferred until the parallel update finishes if called from one of its jobs
   void GenerateTexture();
   /// \brief Gets the generated texture
   /// \return Generated texture
@@ -126,13 +145,16 @@ class Button : public Object::Object
   /// \brief Text to display
   std::string _text;
   /// \brief Shortcut to child text object
-  Text *_textObj;
+  Aspen::Object::Handle<Text> _textObj;
   /// \brief Shortcut to child collider to be clicked on
-  Physics::AABBCollider *_collider;
+  Aspen::Object::Handle<Physics::AABBCollider> _collider;
   /// \brief Shortcut to child rectangle to be drawn behind text
-  Rectangle *_rectangle;
+  Aspen::Object::Handle<Rectangle> _rectangle;
   /// \brief Function to call when the button is clicked on
   ButtonCallback _onClick;
+  /// \brief Position, rotation and scale of this Object
+  ///        Returned by GetTransform
+  Aspen::Transform::Transform _transformComponent;
 
 public:
   /// \brief Constructor
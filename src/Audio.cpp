@@ -41,13 +41,24 @@ SoundEffect::SoundEffect(std::string path, Object *parent, std::string name)
   Load();
 }
 
+SoundEffect::SoundEffect(const SoundEffect &other, Object *parent)
+    : Object(other, parent), _path(other._path), _sound(other._sound)
+{
+}
+
+Object::Object *SoundEffect::Clone(Object *parent) const
+{
+  return new SoundEffect(*this, parent);
+}
+
 void SoundEffect::End()
 {
+  if (DeferEnd())
+    return;
   if (_sound)
   {
     Stop();
-    Mix_FreeChunk(_sound);
-    _sound = nullptr;
+    _sound.reset();
   }
   Object::End();
 }
@@ -65,20 +76,16 @@ std::string SoundEffect::GetPath()
 
 Mix_Chunk *SoundEffect::GetSound()
 {
-  return _sound;
+  return _sound.get();
 }
 
 bool SoundEffect::Load()
 {
   if (!Valid())
     return false;
-  if (_sound)
-  {
-    Mix_FreeChunk(_sound);
-    _sound = nullptr;
-  }
+  _sound.reset();
 
-  _sound = Mix_LoadWAV(_path.c_str());
+  _sound = std::shared_ptr<Mix_Chunk>(Mix_LoadWAV(_path.c_str()), Mix_FreeChunk);
   if (!_sound)
   {
     Log::Error("%s faild to load sound from path: %s", Name().c_str(), _path.c_str());
@@ -92,7 +99,7 @@ void SoundEffect::Play(int channel)
   if (!Valid())
     return;
   if (_sound)
-    _channels.push_back(Mix_PlayChannel(channel, _sound, 0));
+    _channels.push_back(Mix_PlayChannel(channel, _sound.get(), 0));
 }
 
 void SoundEffect::Stop()
@@ -110,7 +117,7 @@ void SoundEffect::Stop()
 
 bool SoundEffect::IsPlayingOn(int channel)
 {
-  return Mix_GetChunk(channel) == _sound && Mix_Playing(channel);
+  return Mix_GetChunk(channel) == _sound.get() && Mix_Playing(channel);
 }
 
 bool SoundEffect::IsPlaying()
@@ -137,7 +144,7 @@ void SoundEffect::OnDeactivate()
 
 /////////////////////////////////////////////////////////
 
-Music *Music::_lastPlayed = nullptr;
+Aspen::Object::Handle<Music> Music::_lastPlayed;
 
 Music::Music(Object *parent, std::string name)
     : Music("", parent, name)
@@ -172,6 +179,8 @@ Music::Music(std::string path, Object *parent, std::string name)
 
 void Music::End()
 {
+  if (DeferEnd())
+    return;
   if (_music)
   {
     Mix_FreeMusic(_music);
@@ -253,7 +262,7 @@ void Music::Stop(double fadeOut)
 
 bool Music::IsPlaying()
 {
-  return Mix_PlayingMusic() && _lastPlayed == this;
+  return Mix_PlayingMusic() && _lastPlayed.Get() == this;
 }
 
 void Music::OnDeactivate()
@@ -297,7 +306,7 @@ Audio::~Audio()
 
 void Audio::End()
 {
-  if (!Valid())
+  if (!Valid() || DeferEnd())
     return;
   Object::End();
   if (_acount-- == 1)
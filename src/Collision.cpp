@@ -1,6 +1,7 @@
 #define __COLLISION_CPP
 
 #include "Collision.hpp"
+#include "Physics.hpp"
 
 #undef __COLLISION_CPP
 
@@ -2,7 +2,6 @@
 
 #include "Controller.hpp"
 #include "Engine.hpp"
-#include "Time.hpp"
 #include "Transform.hpp"
 #include "Physics.hpp"
 #include "Input.hpp"
@@ -26,12 +25,24 @@ PlayerController_8Way::PlayerController_8Way(Object *parent, std::string name)
 }
 
 PlayerController_8Way::PlayerController_8Way(SDL_Keycode up, SDL_Keycode down, SDL_Keycode left, SDL_Keycode right, double speed, double acceleration, Object *parent, std::string name)
-    : Object(parent, "PlayerController_8Way"), _acceleration(acceleration), _speed(speed)
+    : Object(parent, "PlayerController_8Way"), _acceleration(acceleration), _speed(speed), _registryEntry(this)
 {
+  // Moves the parent using the Axis values after they update
+  _updatesOwnChildren = true;
   AddChild(new Input::Axis(up, down, 0.1f, 0.1f, this, "Axis-Vertical"));
   AddChild(new Input::Axis(right, left, 0.1f, 0.1f, this, "Axis-Horizontal"));
 }
 
+PlayerController_8Way::PlayerController_8Way(const PlayerController_8Way &other, Object *parent)
+    : Object(other, parent), _acceleration(other._acceleration), _speed(other._speed), _registryEntry(this)
+{
+}
+
+Object::Object *PlayerController_8Way::Clone(Object *parent) const
+{
+  return new PlayerController_8Way(*this, parent);
+}
+
 void PlayerController_8Way::operator()()
 {
   if (!_parent)
@@ -46,7 +57,7 @@ void PlayerController_8Way::operator()()
     tf = _parent->GetTransform();
     if (!tf)
     {
-      Log::Error("%s needs a parent with a child Transform::Transform!", Name().c_str());
+      Log::Error("%s needs a parent with a Transform (see Object::GetTransform and Object::CreateTransform)!", Name().c_str());
       return;
     }
   }
@@ -58,24 +69,36 @@ void PlayerController_8Way::operator()()
 
   Object::operator()();
 
+  Engine::Engine *engine = Engine::Engine::Get();
+  if ((!engine || engine->FixedTimestep() <= 0.0) && UpdateDue())
+    Step(UpdateDeltaTime() * 60.0);
+}
+
+void PlayerController_8Way::Step(double dt)
+{
+  if (!_parent)
+    return;
+  Physics::Rigidbody *rb = _parent->GetRigidbody();
+  Transform::Transform *tf = _parent->GetTransform();
+  if (!rb || !tf)
+    return;
+
   Input::Axis *av = nullptr;
   Input::Axis *ah = nullptr;
-  for (Input::Axis *a : FindChildrenOfType<Input::Axis>())
-  {
+  ForEachChildOfType<Input::Axis>([&av, &ah](Input::Axis *a) {
     if (!av && a->Name() == "Axis-Vertical")
       av = a;
     else if (!ah && a->Name() == "Axis-Horizontal")
       ah = a;
-    if (ah && av)
-      break;
-  }
+    return !(ah && av);
+  });
   if (!ah || !av)
   {
     Log::Error("%s requires two children of type Axis named Axis-Vertical and Axis-Horizontal!", Name().c_str());
     return;
   }
-  double dx = ah->GetValue() * _acceleration;
-  double dy = av->GetValue() * _acceleration;
+  double dx = ah->GetValue() * _acceleration * dt;
+  double dy = av->GetValue() * _acceleration * dt;
   if (!rb)
     tf->ModifyPosition(dx, dy);
   else
@@ -115,15 +138,13 @@ void PlayerController_8Way::PopulateDebugger()
   {
     Input::Axis *av = nullptr;
     Input::Axis *ah = nullptr;
-    for (Input::Axis *a : FindChildrenOfType<Input::Axis>())
-    {
+    ForEachChildOfType<Input::Axis>([&av, &ah](Input::Axis *a) {
       if (!av && a->Name() == "Axis-Vertical")
         av = a;
       else if (!ah && a->Name() == "Axis-Horizontal")
         ah = a;
-      if (ah && av)
-        break;
-    }
+      return !(ah && av);
+    });
     if (av && ah)
     {
       double dx = ah->GetValue() * _acceleration;
@@ -143,11 +164,24 @@ PlayerController_Sidescroller::PlayerController_Sidescroller(Object *parent, std
 }
 
 PlayerController_Sidescroller::PlayerController_Sidescroller(SDL_Keycode left, SDL_Keycode right, SDL_Keycode jump, double speed, double acceleration, double jumpStrength, double jumpHeight, Object *parent, std::string name)
-    : Object(parent, name), _acceleration(acceleration), _speed(speed), _jumpStrength(jumpStrength), _jumpHeight(jumpHeight), _jumpRemaining(0), _jumpKey(jump)
+    : Object(parent, name), _acceleration(acceleration), _speed(speed), _jumpStrength(jumpStrength), _jumpHeight(jumpHeight), _jumpRemaining(0), _jumpKey(jump), _jumpPressed(false), _jumpReleased(false), _registryEntry(this)
 {
+  // Moves the parent using the Axis values after they update
+  _updatesOwnChildren = true;
   AddChild(new Input::Axis(right, left, 0.1f, 0.1f, this, "Axis-Horizontal"));
 }
 
+PlayerController_Sidescroller::PlayerController_Sidescroller(const PlayerController_Sidescroller &other, Object *parent)
+    : Object(other, parent), _acceleration(other._acceleration), _speed(other._speed), _jumpStrength(other._jumpStrength), _jumpHeight(other._jumpHeight),
+      _jumpRemaining(0), _jumpKey(other._jumpKey), _jumpPressed(false), _jumpReleased(false), _registryEntry(this)
+{
+}
+
+Object::Object *PlayerController_Sidescroller::Clone(Object *parent) const
+{
+  return new PlayerController_Sidescroller(*this, parent);
+}
+
 void PlayerController_Sidescroller::operator()()
 {
   if (!_parent)
@@ -162,7 +196,7 @@ void PlayerController_Sidescroller::operator()()
     tf = _parent->GetTransform();
     if (!tf)
     {
-      Log::Error("%s needs a parent with a child Transform::Transform!", Name().c_str());
+      Log::Error("%s needs a parent with a Transform (see Object::GetTransform and Object::CreateTransform)!", Name().c_str());
       return;
     }
   }
@@ -174,24 +208,38 @@ void PlayerController_Sidescroller::operator()()
 
   Object::operator()();
 
-  double dt = 1.0;
+  // Latched so a press isn't missed by a frame that runs no fixed ticks
+  if (Input::KeyPressed(_jumpKey))
+    _jumpPressed = true;
+  if (Input::KeyReleased(_jumpKey))
+    _jumpReleased = true;
+
   Engine::Engine *engine = Engine::Engine::Get();
-  if (engine)
-  {
-    Time::Time *time = Time::Time::Get();
-    if (time)
-      dt = time->DeltaTime() * 60;
-  }
+  if ((!engine || engine->FixedTimestep() <= 0.0) && UpdateDue())
+    Step(UpdateDeltaTime() * 60.0);
+}
+
+void PlayerController_Sidescroller::Step(double dt)
+{
+  if (!_parent)
+    return;
+  Physics::Rigidbody *rb = _parent->GetRigidbody();
+  Transform::Transform *tf = _parent->GetTransform();
+  if (!rb || !tf)
+    return;
+
+  bool pressed = _jumpPressed;
+  bool released = _jumpReleased;
+  _jumpPressed = false;
+  _jumpReleased = false;
 
   Input::Axis *ah = nullptr;
-  for (Input::Axis *a : FindChildrenOfType<Input::Axis>())
-  {
-    if (!ah && a->Name() == "Axis-Horizontal")
-    {
-      ah = a;
-      break;
-    }
-  }
+  ForEachChildOfType<Input::Axis>([&ah](Input::Axis *a) {
+    if (a->Name() != "Axis-Horizontal")
+      return true;
+    ah = a;
+    return false;
+  });
   if (!ah)
   {
     Log::Error("%s requires a child of type Axis named Axis-Horizontal!", Name().c_str());
@@ -199,17 +247,17 @@ void PlayerController_Sidescroller::operator()()
   }
   double dx = ah->GetValue() * _acceleration * dt;
   if (!rb)
-    tf->ModifyPosition(dx, Input::KeyPressed(_jumpKey) ? -1 * _jumpStrength : 0.0);
+    tf->ModifyPosition(dx, pressed ? -1 * _jumpStrength : 0.0);
   else
   {
     double vx = rb->GetVelocityX();
     if (std::abs(vx) < _speed || Sign(vx) != Sign(dx))
       rb->ApplyCartesianForce(dx, 0);
-    if (Input::KeyPressed(_jumpKey))
+    if (pressed)
       _jumpRemaining = _jumpHeight;
     if (_jumpRemaining > 0)
     {
-      if (Input::KeyReleased(_jumpKey))
+      if (released)
         _jumpRemaining = 0.0;
       else
         _jumpRemaining -= dt / 60.0;
@@ -274,14 +322,12 @@ void PlayerController_Sidescroller::PopulateDebugger()
   _jumpHeight = jh;
   ImGui::Text("Jump Key: %s", SDL_GetKeyName(_jumpKey));
   Input::Axis *ah = nullptr;
-  for (Input::Axis *a : FindChildrenOfType<Input::Axis>())
-  {
-    if (!ah && a->Name() == "Axis-Horizontal")
-    {
-      ah = a;
-      break;
-    }
-  }
+  ForEachChildOfType<Input::Axis>([&ah](Input::Axis *a) {
+    if (a->Name() != "Axis-Horizontal")
+      return true;
+    ah = a;
+    return false;
+  });
   if (ah)
   {
     double dx = ah->GetValue() * _acceleration;
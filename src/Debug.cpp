@@ -5,6 +5,7 @@
 #include "Engine.hpp"
 #include "Input.hpp"
 #include "Graphics.hpp"
+#include "Profiler.hpp"
 #include "imgui_sdl.h"
 #include <algorithm>
 
@@ -19,6 +20,8 @@ unsigned Debug::_dcount = 0;
 Debug::Debug(Object *parent, std::string name)
     : Object(parent, name), _io(nullptr), _toClose(8), _toOpen(8)
 {
+  // Draws the windows after the children update
+  _updatesOwnChildren = true;
   if (_dcount++ == 0)
     ImGui::CreateContext();
   if (_parent)
@@ -70,6 +73,10 @@ void Debug::operator()()
     else
       sprintf(buffer, "FPS: ???");
     ImGui::Text(buffer);
+#ifdef __PROFILE
+    if (ImGui::Button("Write Trace"))
+      Profiler::WriteTrace("trace.json", 120);
+#endif
     MakeTree(Root());
     _toClose.clear();
     _toOpen.clear();
@@ -145,6 +152,7 @@ void Debug::PopulateDebugger()
 {
   ImGui::Text("ImGuiIO: %p", _io);
   ImGui::Text("Debugger Count: %d", _dcount);
+  ImGui::Text("Pooled Objects: %u (%u KiB)", Object::PooledCount(), unsigned(Object::PooledBytes() / 1024));
   Object::PopulateDebugger();
 }
 } // namespace Debug
@@ -9,8 +9,12 @@
 #include "Log.hpp"
 #include "GameState.hpp"
 #include "Audio.hpp"
+#include "Transform.hpp"
+#include "Controller.hpp"
+#include "Profiler.hpp"
 #include "imgui.h"
 #include <SDL2/SDL.h>
+#include <algorithm>
 
 #undef __ENGINE_CPP
 
@@ -20,6 +24,9 @@ namespace Engine
 {
 const Version::Version VERSION(0, 2, 0, Version::TIER::PREALPHA);
 const unsigned SDL_INIT_FLAGS = SDL_INIT_VIDEO | SDL_INIT_AUDIO;
+const unsigned SDL_INIT_FLAGS_HEADLESS = SDL_INIT_EVENTS;
+const double MAX_FRAME_TIME = 0.25;
+const double NOMINAL_FRAME_TIME = 1.0 / 60.0;
 
 unsigned Engine::_ecount = 0;
 Engine *Engine::_main = nullptr;
@@ -29,17 +36,19 @@ Engine::Engine(Object *parent, std::string name)
 {
 }
 Engine::Engine(int flags, Object *parent, std::string name)
-    : Object(parent, name), _debugging(flags & START_FLAGS::DEBUGGING_ON)
+    : Object(parent, name), _debugging(flags & START_FLAGS::DEBUGGING_ON), _headless(flags & START_FLAGS::HEADLESS)
 {
-  if (_ecount == 0)
+  unsigned sdlFlags = _headless ? SDL_INIT_FLAGS_HEADLESS : SDL_INIT_FLAGS;
+  if (SDL_WasInit(sdlFlags) != sdlFlags)
   {
-    if (SDL_Init(SDL_INIT_FLAGS) < 0)
+    if (SDL_InitSubSystem(sdlFlags) < 0)
     {
       Log::Error("Could not initialize SDL. SDL_Error: %s", SDL_GetError());
       _valid = false;
       return;
     }
-    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1");
+    if (!_headless)
+      SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1");
   }
 
   Log::Info("Creating Engine with the following flags:");
@@ -103,10 +112,18 @@ Engine::Engine(int flags, Object *parent, std::string name)
       Log::Info("  CREATE_GAMESTATEMANAGER");
     if (flags & START_FLAGS::CREATE_AUDIO)
       Log::Info("  CREATE_AUDIO");
+    if (flags & START_FLAGS::HEADLESS)
+    {
+      Log::Info("  HEADLESS");
+      if (flags & START_FLAGS::CREATE_GRAPHICS)
+        Log::Warning("    CREATE_GRAPHICS will be ignored");
+      if (flags & START_FLAGS::CREATE_AUDIO)
+        Log::Warning("    CREATE_AUDIO will be ignored");
+    }
     if (flags & START_FLAGS::DEBUGGING_ON)
       Log::Info("  DEBUGGING_ON");
 
-    if (flags & START_FLAGS::CREATE_GRAPHICS)
+    if ((flags & START_FLAGS::CREATE_GRAPHICS) && !_headless)
     {
       Graphics::Graphics *gfx = CreateChild<Graphics::Graphics>();
       if (flags & START_FLAGS::CREATE_GRAPHICS_DEBUGGER)
@@ -119,80 +136,8 @@ Engine::Engine(int flags, Object *parent, std::string name)
       Event::EventHandler *eh = CreateChild<Event::EventHandler>();
       if (flags & START_FLAGS::CREATE_EVENT_QUIT)
         eh->CreateChild<Event::QuitEventListener>();
-      if (flags & START_FLAGS::CREATE_EVENT_KEYS_ALPHA)
-        for (int i = static_cast<int>(SDLK_a); i <= static_cast<int>(SDLK_z); ++i)
-          eh->AddChild(new Event::KeyEventListener(static_cast<SDL_Keycode>(i), eh, std::string("KeyEventListener-") + SDL_GetKeyName(i)));
-      if (flags & START_FLAGS::CREATE_EVENT_KEYS_NUM)
-        for (int i = static_cast<int>(SDLK_0); i <= static_cast<int>(SDLK_9); ++i)
-          eh->AddChild(new Event::KeyEventListener(static_cast<SDL_Keycode>(i), eh, std::string("KeyEventListener-") + SDL_GetKeyName(i)));
-      if (flags & START_FLAGS::CREATE_EVENT_KEYS_SPECIAL)
-      {
-        eh->AddChild(new Event::KeyEventListener(SDLK_SPACE, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_SPACE)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_ESCAPE, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_ESCAPE)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_BACKSPACE, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_BACKSPACE)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_DELETE, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_DELETE)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_SLASH, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_SLASH)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_BACKSLASH, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_BACKSLASH)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_PERIOD, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_PERIOD)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_COMMA, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_COMMA)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_CAPSLOCK, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_CAPSLOCK)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_SCROLLLOCK, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_SCROLLLOCK)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_NUMLOCKCLEAR, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_NUMLOCKCLEAR)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_RGUI, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_RGUI)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_LGUI, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_LGUI)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_LALT, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_LALT)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_RALT, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_RALT)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_LCTRL, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_LCTRL)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_RCTRL, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_RCTRL)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_MENU, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_MENU)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_SEMICOLON, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_SEMICOLON)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_QUOTE, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_QUOTE)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_MINUS, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_MINUS)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_EQUALS, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_EQUALS)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_LEFTBRACKET, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_LEFTBRACKET)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_RIGHTBRACKET, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_RIGHTBRACKET)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_LSHIFT, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_LSHIFT)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_RSHIFT, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_RSHIFT)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_TAB, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_TAB)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_RETURN, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_RETURN)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_LEFT, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_LEFT)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_RIGHT, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_RIGHT)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_UP, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_UP)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_DOWN, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_DOWN)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_HOME, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_HOME)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_END, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_END)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_PAGEDOWN, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_PAGEDOWN)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_PAGEUP, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_PAGEUP)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_INSERT, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_INSERT)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_PRINTSCREEN, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_PRINTSCREEN)));
-      }
-      if (flags & START_FLAGS::CREATE_EVENT_KEYS_FUNCTION)
-      {
-        eh->AddChild(new Event::KeyEventListener(SDLK_F1, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_F1)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_F2, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_F2)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_F3, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_F3)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_F4, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_F4)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_F5, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_F5)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_F6, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_F6)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_F7, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_F7)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_F8, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_F8)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_F9, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_F9)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_F10, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_F10)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_F11, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_F11)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_F12, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_F12)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_F13, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_F13)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_F14, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_F14)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_F15, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_F15)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_F16, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_F16)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_F17, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_F17)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_F18, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_F18)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_F19, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_F19)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_F20, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_F20)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_F21, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_F21)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_F22, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_F22)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_F23, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_F23)));
-        eh->AddChild(new Event::KeyEventListener(SDLK_F24, eh, std::string("KeyEventListener-") + SDL_GetKeyName(SDLK_F24)));
-      }
+      if (flags & START_FLAGS::CREATE_EVENT_KEYS_ALL)
+        eh->CreateChild<Event::KeyboardEventListener>();
       if (flags & START_FLAGS::CREATE_EVENT_MOUSE)
         eh->CreateChild<Event::MouseEventListener>();
     }
@@ -202,7 +147,7 @@ Engine::Engine(int flags, Object *parent, std::string name)
       CreateChild<Physics::Physics>();
     if (flags & START_FLAGS::CREATE_GAMESTATEMANAGER)
       CreateChild<GameState::GameStateManager>();
-    if (flags & START_FLAGS::CREATE_AUDIO)
+    if ((flags & START_FLAGS::CREATE_AUDIO) && !_headless)
       CreateChild<Audio::Audio>();
   }
 
@@ -219,7 +164,7 @@ Engine::~Engine()
   _children.clear();
   if (_main == this)
     _main = nullptr;
-  if (_ecount-- == 1 && SDL_WasInit(SDL_INIT_FLAGS) == SDL_INIT_FLAGS)
+  if (_ecount-- == 1 && SDL_WasInit(SDL_INIT_EVERYTHING))
     SDL_Quit();
 }
 
@@ -232,9 +177,87 @@ void Engine::operator()()
 {
   if (!Active())
     return;
-  OnEarlyUpdate();
-  Object::operator()();
-  OnLateUpdate();
+  ASPEN_PROFILE_FRAME();
+  ASPEN_PROFILE_ZONE("Engine");
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  double frameTime = std::min(std::chrono::duration<double>(now - _lastFrame).count(), MAX_FRAME_TIME);
+  _lastFrame = now;
+  if (_headless)
+    frameTime = _timestep > 0.0 ? _timestep : NOMINAL_FRAME_TIME;
+  if (_main == this)
+    AdvanceFrame(frameTime);
+  if (_timestep > 0.0)
+  {
+    _accumulator += frameTime;
+    while (_accumulator >= _timestep)
+    {
+      Tick();
+      _accumulator -= _timestep;
+    }
+    // Only drawing is blended, so everything updated below still reads the values from the last tick
+    Transform::Transform::SetDrawInterpolation(TickProgress());
+  }
+  if (_phases & Aspen::Object::PHASES::EARLY_UPDATE)
+    OnEarlyUpdate();
+  RunPhase(Aspen::Object::PHASES::EARLY_UPDATE);
+  UpdateTree(&_traversal);
+  if (_phases & Aspen::Object::PHASES::LATE_UPDATE)
+    OnLateUpdate();
+  RunPhase(Aspen::Object::PHASES::LATE_UPDATE);
+  Transform::Transform::SetDrawInterpolation(1.0);
+  DestroyEnded();
+}
+
+void Engine::Tick()
+{
+  ASPEN_PROFILE_ZONE("Engine::Tick");
+  Aspen::Object::Registry<Transform::Transform>::ForEach([](Transform::Transform *tf) {
+    tf->SaveState();
+  });
+  Physics::Physics *physics = FindChildOfType<Physics::Physics>();
+  if (physics && physics->Active() && !physics->Sleeping())
+    physics->Step();
+  for (Controller::PlayerController_8Way *pc : Aspen::Object::Registry<Controller::PlayerController_8Way>::Under(this))
+    if (pc->Active() && !pc->Sleeping() && pc->UpdateDue(_ticks))
+      pc->Step(_timestep * 60.0 * pc->UpdateInterval());
+  for (Controller::PlayerController_Sidescroller *pc : Aspen::Object::Registry<Controller::PlayerController_Sidescroller>::Under(this))
+    if (pc->Active() && !pc->Sleeping() && pc->UpdateDue(_ticks))
+      pc->Step(_timestep * 60.0 * pc->UpdateInterval());
+  if (physics)
+    physics->Integrate(this);
+  else
+    for (Physics::Rigidbody *rb : Aspen::Object::Registry<Physics::Rigidbody>::Under(this))
+      if (rb->Active() && !rb->Sleeping() && rb->UpdateDue(_ticks))
+        rb->Step(_timestep * 60.0 * rb->UpdateInterval());
+  for (Graphics::Animation *a : Aspen::Object::Registry<Graphics::Animation>::Under(this))
+    if (a->Active() && !a->Sleeping() && a->UpdateDue(_ticks))
+      a->Step(_timestep * a->UpdateInterval());
+  ++_ticks;
+}
+
+double Engine::FixedTimestep()
+{
+  return _timestep;
+}
+
+void Engine::FixedTimestep(double timestep)
+{
+  _timestep = std::max(0.0, timestep);
+  _accumulator = 0.0;
+  _ticks = 0;
+  _lastFrame = std::chrono::steady_clock::now();
+}
+
+double Engine::TickProgress()
+{
+  if (_timestep > 0.0)
+    return std::min(_accumulator / _timestep, 1.0);
+  return 1.0;
+}
+
+unsigned long long Engine::Ticks()
+{
+  return _ticks;
 }
 
 bool Engine::Debug()
@@ -247,9 +270,21 @@ void Engine::Debug(bool newval)
   _debugging = newval;
 }
 
+bool Engine::Headless()
+{
+  return _headless;
+}
+
 void Engine::PopulateDebugger()
 {
   ImGui::Text("Debugging: %s", Debug() ? "True" : "False");
+  if (_timestep > 0.0)
+  {
+    ImGui::Text("Fixed Timestep: %f", _timestep);
+    ImGui::Text("Ticks: %llu", _ticks);
+    ImGui::Text("Tick Progress: %f", TickProgress());
+  }
+  ImGui::Text("Updated Objects: %u", _traversal.Size());
   Object::PopulateDebugger();
 }
 } // namespace Engine
@@ -6,6 +6,7 @@
 #include "Graphics.hpp"
 #include "Engine.hpp"
 #include "Transform.hpp"
+#include "Profiler.hpp"
 #include "imgui.h"
 
 #undef __EVENT_CPP
@@ -15,7 +16,7 @@ namespace Aspen
 namespace Event
 {
 EventListener::EventListener(Object *parent, std::string name)
-    : Object(parent, name)
+    : Object(parent, name), _registryEntry(this)
 {
 }
 
@@ -60,6 +61,34 @@ void QuitEventListener::PopulateDebugger()
   EventListener::PopulateDebugger();
 }
 
+KeyboardEventListener::KeyboardEventListener(Object *parent, std::string name)
+    : EventListener(parent, name)
+{
+}
+
+KeyboardEventListener::~KeyboardEventListener()
+{
+}
+
+void KeyboardEventListener::Handle(SDL_Event *event)
+{
+  if (event && (event->type == SDL_KEYDOWN || event->type == SDL_KEYUP))
+  {
+    if (Input::HandleKeyEvent(event->key) && Engine::Engine::Get() && Engine::Engine::Get()->Debug())
+      Log::Debug("Key %s: %s", event->type == SDL_KEYDOWN ? "down" : "up", SDL_GetKeyName(event->key.keysym.sym));
+  }
+}
+
+void KeyboardEventListener::PopulateDebugger()
+{
+  std::string held;
+  for (int s = SDL_SCANCODE_UNKNOWN + 1; s < SDL_NUM_SCANCODES; ++s)
+    if (Input::KeyHeld(static_cast<SDL_Scancode>(s)))
+      held += std::string(held.empty() ? "" : ", ") + SDL_GetScancodeName(static_cast<SDL_Scancode>(s));
+  ImGui::Text("Held: %s", held.c_str());
+  EventListener::PopulateDebugger();
+}
+
 KeyEventListener::KeyEventListener(Object *parent, std::string name)
     : EventListener(parent, name), _key(SDLK_UNKNOWN)
 {
@@ -74,15 +103,6 @@ KeyEventListener::~KeyEventListener()
 {
 }
 
-void KeyEventListener::operator()()
-{
-  Input::Key &k = Input::GetKey(_key);
-  if (k.pressed)
-    k.pressed = false;
-  if (k.released)
-    k.released = false;
-}
-
 void KeyEventListener::SetKey(SDL_Keycode k)
 {
   _key = k;
@@ -90,25 +110,12 @@ void KeyEventListener::SetKey(SDL_Keycode k)
 
 void KeyEventListener::Handle(SDL_Event *event)
 {
-  if (event && _key != SDLK_UNKNOWN)
+  if (event && _key != SDLK_UNKNOWN && (event->type == SDL_KEYDOWN || event->type == SDL_KEYUP))
   {
-    Input::Key &k = Input::GetKey(_key);
-    if (event->key.keysym.sym == _key)
+    if (event->key.keysym.sym == _key && Input::HandleKeyEvent(event->key))
     {
-      if (event->type == SDL_KEYDOWN && !k.held)
-      {
-        k.pressed = true;
-        k.held = true;
-        if (Engine::Engine::Get() && Engine::Engine::Get()->Debug())
-          Log::Debug("Key down: %s", SDL_GetKeyName(_key));
-      }
-      else if (event->type == SDL_KEYUP && k.held)
-      {
-        k.held = false;
-        k.released = true;
-        if (Engine::Engine::Get() && Engine::Engine::Get()->Debug())
-          Log::Debug("Key up: %s", SDL_GetKeyName(_key));
-      }
+      if (Engine::Engine::Get() && Engine::Engine::Get()->Debug())
+        Log::Debug("Key %s: %s", event->type == SDL_KEYDOWN ? "down" : "up", SDL_GetKeyName(_key));
     }
   }
 }
@@ -124,6 +131,8 @@ void KeyEventListener::PopulateDebugger()
 EventHandler::EventHandler(Object *parent, std::string name)
     : Object(parent, name)
 {
+  // Listeners reset their state when they update, so events are polled after them
+  _updatesOwnChildren = true;
 }
 
 EventHandler::~EventHandler()
@@ -135,11 +144,14 @@ void EventHandler::operator()()
   if (!Active())
     return;
   Object::operator()();
+  ASPEN_PROFILE_ZONE("EventHandler::Poll");
+  Input::ClearKeyEdges();
   SDL_Event event;
-  std::vector<EventListener *> listeners = FindChildrenOfType<EventListener>();
   while (SDL_PollEvent(&event))
-    for (EventListener *el : listeners)
-      (*el)(&event);
+    Aspen::Object::Registry<EventListener>::ForEach([this, &event](EventListener *el) {
+      if (el->Parent() == this)
+        (*el)(&event);
+    });
 }
 
 void EventHandler::PopulateDebugger()
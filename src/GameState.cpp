@@ -1,6 +1,7 @@
 #define __GAMESTATE_CPP
 
 #include "GameState.hpp"
+#include "Scene.hpp"
 #include <fstream>
 
 #undef __GAMESTATE_CPP
@@ -25,6 +26,16 @@ void GameState::StateName(std::string state)
   _state = state;
 }
 
+bool GameState::LoadScene(std::string path)
+{
+  return Scene::Load(path, this);
+}
+
+bool GameState::SaveScene(std::string path)
+{
+  return Scene::Save(this, path);
+}
+
 GameStateManager::GameStateManager(Object *parent, std::string name)
     : Object(parent, name)
 {
@@ -5,8 +5,8 @@
 #include "Engine.hpp"
 #include "Transform.hpp"
 #include "Debug.hpp"
-#include "Time.hpp"
 #include "Log.hpp"
+#include "Profiler.hpp"
 #include <sstream>
 #include <iomanip>
 #include <cmath>
@@ -96,9 +96,20 @@ Geometry::Geometry(Object *parent, std::string name)
 }
 
 Geometry::Geometry(Aspen::Graphics::Color c, bool fill, Object *parent, std::string name)
-    : Object(parent, name), _c(c), _fill(fill)
+    : Object(parent, name), _c(c), _fill(fill), _transformComponent(this)
 {
-  CreateChild<Transform::Transform>();
+  _draws = true;
+}
+
+Geometry::Geometry(const Geometry &other, Object *parent)
+    : Object(other, parent), _c(other._c), _fill(other._fill), _transformComponent(this)
+{
+  _transformComponent = other._transformComponent;
+}
+
+Object::Object *Geometry::Clone(Object *parent) const
+{
+  return new Geometry(*this, parent);
 }
 
 Geometry::~Geometry()
@@ -155,6 +166,16 @@ Rectangle::Rectangle(SDL_Rect rect, Aspen::Graphics::Color c, bool fill, Object
 {
 }
 
+Rectangle::Rectangle(const Rectangle &other, Object *parent)
+    : Geometry(other, parent), _rect(other._rect)
+{
+}
+
+Object::Object *Rectangle::Clone(Object *parent) const
+{
+  return new Rectangle(*this, parent);
+}
+
 Rectangle::~Rectangle()
 {
 }
@@ -169,7 +190,7 @@ void Rectangle::operator()()
     Graphics *gfx = Graphics::Get();
     if (gfx)
       gfx->DrawRectangle(this);
-    else
+    else if (!engine->Headless())
       Log::Error("%s requires an ancestor Engine with child Graphics!", Name().c_str());
   }
   else
@@ -203,6 +224,16 @@ Point::Point(SDL_Point point, Aspen::Graphics::Color c, Object *parent, std::str
 {
 }
 
+Point::Point(const Point &other, Object *parent)
+    : Geometry(other, parent), _point(other._point)
+{
+}
+
+Object::Object *Point::Clone(Object *parent) const
+{
+  return new Point(*this, parent);
+}
+
 Point::~Point()
 {
 }
@@ -217,7 +248,7 @@ void Point::operator()()
     Graphics *gfx = Graphics::Get();
     if (gfx)
       gfx->DrawPoint(this);
-    else
+    else if (!engine->Headless())
       Log::Error("%s requires an ancestor Engine with child Graphics!", Name().c_str());
   }
   else
@@ -249,6 +280,16 @@ Line::Line(SDL_Point start, SDL_Point end, float center, Aspen::Graphics::Color
 {
 }
 
+Line::Line(const Line &other, Object *parent)
+    : Geometry(other, parent), _start(other._start), _end(other._end), _center(other._center)
+{
+}
+
+Object::Object *Line::Clone(Object *parent) const
+{
+  return new Line(*this, parent);
+}
+
 Line::~Line()
 {
 }
@@ -263,7 +304,7 @@ void Line::operator()()
     Graphics *gfx = Graphics::Get();
     if (gfx)
       gfx->DrawLine(this);
-    else
+    else if (!engine->Headless())
       Log::Error("%s requires an ancestor Engine with child Graphics!", Name().c_str());
   }
   else
@@ -369,9 +410,8 @@ TTF_Font *FontCache::GetFont(std::string name, int size)
 /////////////////////////////////////////////////////////
 
 Camera::Camera(Object *parent, std::string name)
-    : Object(parent, name), _gfx(nullptr)
+    : Object(parent, name), _gfx(), _transformComponent(this)
 {
-  CreateChild<Transform::Transform>();
 }
 
 void Camera::SelectCamera()
@@ -383,14 +423,14 @@ void Camera::SelectCamera()
 
 Graphics *Camera::GetGraphics()
 {
-  return _gfx;
+  return _gfx.Get();
 }
 
 void Camera::SetGraphics(Graphics *gfx)
 {
-  if (_gfx == gfx)
+  Graphics *ogfx = _gfx.Get();
+  if (ogfx == gfx)
     return;
-  Graphics *ogfx = _gfx;
   _gfx = gfx;
   if (ogfx)
     ogfx->SetCamera(nullptr);
@@ -400,14 +440,18 @@ void Camera::SetGraphics(Graphics *gfx)
 
 void Camera::End()
 {
-  if (_gfx)
-    _gfx->SetCamera(nullptr);
+  if (DeferEnd())
+    return;
+  Graphics *gfx = _gfx.Get();
+  if (gfx)
+    gfx->SetCamera(nullptr);
 }
 
 /////////////////////////////////////////////////////////
 
 unsigned Graphics::_gcount = 0;
 Graphics *Graphics::_main = nullptr;
+TextureCache Graphics::_textureCache;
 
 Graphics::Graphics(Object *parent, std::string name)
     : Graphics(DEFAULT_WINDOW_WIDTH, DEFAULT_WINDOW_HEIGHT, parent, name)
@@ -415,8 +459,10 @@ Graphics::Graphics(Object *parent, std::string name)
 }
 
 Graphics::Graphics(int w, int h, Object *parent, std::string name)
-    : Object(parent, name), _window(nullptr), _surface(nullptr), _renderer(nullptr), _background(Color()), _camera(nullptr)
+    : Object(parent, name), _window(nullptr), _surface(nullptr), _renderer(nullptr), _background(Color()), _camera(nullptr), _spriteCount(0), _spriteDrawCalls(0)
 {
+  // Debuggers are drawn last by OnLateUpdate
+  _updatesOwnChildren = true;
   if (_gcount == 0)
   {
     if (SDL_WasInit(Engine::SDL_INIT_FLAGS) != Engine::SDL_INIT_FLAGS)
@@ -546,22 +592,21 @@ Graphics *Graphics::Get()
   return _main;
 }
 
+TextureCache &Graphics::GetTextureCache()
+{
+  return _textureCache;
+}
+
 void Graphics::operator()()
 {
   if (!Active())
     return;
 
-  for (Object *child : _children)
+  for (unsigned i = 0; i < _children.size(); ++i)
   {
+    Object *child = _children[i];
     if (!dynamic_cast<Debug::Debug *>(child))
-    {
       (*child)();
-      if (!child->Valid())
-      {
-        RemoveChild(child);
-        delete child;
-      }
-    }
   }
 }
 
@@ -569,31 +614,38 @@ void Graphics::OnEarlyUpdate()
 {
   SDL_SetRenderDrawColor(_renderer, _background.Red(), _background.Green(), _background.Blue(), _background.Alpha());
   SDL_RenderClear(_renderer);
+  _spriteCount = 0;
+  _spriteDrawCalls = 0;
   Object::OnEarlyUpdate();
 }
 
 void Graphics::OnLateUpdate()
 {
-  for (Object *child : _children)
   {
+    ASPEN_PROFILE_ZONE("Graphics::FlushSprites");
+    FlushSprites();
+  }
+  for (unsigned i = 0; i < _children.size(); ++i)
+  {
+    Object *child = _children[i];
     if (dynamic_cast<Debug::Debug *>(child))
-    {
       (*child)();
-      if (!child->Valid())
-      {
-        RemoveChild(child);
-        delete child;
-      }
-    }
   }
-  SDL_RenderPresent(_renderer);
+  {
+    ASPEN_PROFILE_ZONE("Graphics::Present");
+    SDL_RenderPresent(_renderer);
+  }
   Object::OnLateUpdate();
 }
 
 void Graphics::End()
 {
-  if (!Valid())
+  if (!Valid() || DeferEnd())
     return;
+  _quads.clear();
+  _batches.clear();
+  if (_main == this)
+    _textureCache.Unload();
   if (_renderer)
   {
     SDL_DestroyRenderer(_renderer);
@@ -636,6 +688,13 @@ SDL_Renderer *Graphics::GetRenderer()
 
 void Graphics::DrawRectangle(Rectangle *rect)
 {
+  if (InParallelUpdate())
+  {
+    Defer([this, rect]() { DrawRectangle(rect); });
+    return;
+  }
+  Transform::Transform::DrawScope interpolated;
+  FlushSprites();
   if (rect)
   {
     SDL_SetRenderDrawColor(_renderer, rect->Color().Red(), rect->Color().Green(), rect->Color().Blue(), rect->Color().Alpha());
@@ -670,6 +729,16 @@ void Graphics::DrawRectangle(Rectangle *rect)
 
 void Graphics::DrawRectangle(SDL_Rect *rect, Aspen::Graphics::Color c, bool fill)
 {
+  if (InParallelUpdate())
+  {
+    if (rect)
+    {
+      SDL_Rect r = *rect;
+      Defer([this, r, c, fill]() mutable { DrawRectangle(&r, c, fill); });
+    }
+    return;
+  }
+  FlushSprites();
   if (rect)
   {
     SDL_SetRenderDrawColor(_renderer, c.Red(), c.Green(), c.Blue(), c.Alpha());
@@ -682,6 +751,13 @@ void Graphics::DrawRectangle(SDL_Rect *rect, Aspen::Graphics::Color c, bool fill
 
 void Graphics::DrawPoint(Point *point)
 {
+  if (InParallelUpdate())
+  {
+    Defer([this, point]() { DrawPoint(point); });
+    return;
+  }
+  Transform::Transform::DrawScope interpolated;
+  FlushSprites();
   if (point)
   {
     SDL_SetRenderDrawColor(_renderer, point->Color().Red(), point->Color().Green(), point->Color().Blue(), point->Color().Alpha());
@@ -707,6 +783,16 @@ void Graphics::DrawPoint(Point *point)
 
 void Graphics::DrawPoint(SDL_Point *point, Color c)
 {
+  if (InParallelUpdate())
+  {
+    if (point)
+    {
+      SDL_Point p = *point;
+      Defer([this, p, c]() mutable { DrawPoint(&p, c); });
+    }
+    return;
+  }
+  FlushSprites();
   if (point)
   {
     SDL_SetRenderDrawColor(_renderer, c.Red(), c.Green(), c.Blue(), c.Alpha());
@@ -716,6 +802,13 @@ void Graphics::DrawPoint(SDL_Point *point, Color c)
 
 void Graphics::DrawLine(Line *line)
 {
+  if (InParallelUpdate())
+  {
+    Defer([this, line]() { DrawLine(line); });
+    return;
+  }
+  Transform::Transform::DrawScope interpolated;
+  FlushSprites();
   if (line)
   {
     SDL_SetRenderDrawColor(_renderer, line->Color().Red(), line->Color().Green(), line->Color().Blue(), line->Color().Alpha());
@@ -767,6 +860,17 @@ void Graphics::DrawLine(Line *line)
 
 void Graphics::DrawLine(SDL_Point *start, SDL_Point *end, Color c)
 {
+  if (InParallelUpdate())
+  {
+    if (start && end)
+    {
+      SDL_Point s = *start;
+      SDL_Point e = *end;
+      Defer([this, s, e, c]() mutable { DrawLine(&s, &e, c); });
+    }
+    return;
+  }
+  FlushSprites();
   if (start && end)
   {
     SDL_SetRenderDrawColor(_renderer, c.Red(), c.Green(), c.Blue(), c.Alpha());
@@ -776,6 +880,12 @@ void Graphics::DrawLine(SDL_Point *start, SDL_Point *end, Color c)
 
 void Graphics::DrawSprite(Sprite *sprite)
 {
+  if (InParallelUpdate())
+  {
+    Defer([this, sprite]() { DrawSprite(sprite); });
+    return;
+  }
+  Transform::Transform::DrawScope interpolated;
   if (sprite && sprite->GetTexture())
   {
     SDL_Rect rect = sprite->GetRect();
@@ -803,14 +913,19 @@ void Graphics::DrawSprite(Sprite *sprite)
     }
     rect.x -= rect.w / 2;
     rect.y -= rect.h / 2;
-    if (angle == 0)
-      angle = 0.00000001;
-    SDL_RenderCopyEx(_renderer, sprite->GetTexture(), NULL, &rect, (angle / M_PI) * 180.0, NULL, SDL_FLIP_NONE);
+    const std::shared_ptr<Texture> &texture = sprite->GetSharedTexture();
+    QueueSprite(texture, SDL_Rect{0, 0, texture->GetWidth(), texture->GetHeight()}, rect, angle);
   }
 }
 
 void Graphics::DrawSprite(Sprite *sprite, SDL_Rect clip)
 {
+  if (InParallelUpdate())
+  {
+    Defer([this, sprite, clip]() { DrawSprite(sprite, clip); });
+    return;
+  }
+  Transform::Transform::DrawScope interpolated;
   if (sprite && sprite->GetTexture())
   {
     SDL_Rect rect = sprite->GetRect();
@@ -838,14 +953,79 @@ void Graphics::DrawSprite(Sprite *sprite, SDL_Rect clip)
     }
     rect.x -= rect.w / 2;
     rect.y -= rect.h / 2;
-    if (angle == 0)
-      angle = 0.00000001;
-    SDL_RenderCopyEx(_renderer, sprite->GetTexture(), &clip, &rect, (angle / M_PI) * 180.0, NULL, SDL_FLIP_NONE);
+    QueueSprite(sprite->GetSharedTexture(), clip, rect, angle);
   }
 }
 
+void Graphics::QueueSprite(const std::shared_ptr<Texture> &texture, SDL_Rect src, SDL_Rect dst, double angle)
+{
+  if (_batches.empty() || _batches.back().texture != texture)
+    _batches.push_back(SpriteBatch{texture, unsigned(_quads.size()), 0});
+  _quads.push_back(SpriteQuad{src, dst, angle});
+  ++_batches.back().count;
+  ++_spriteCount;
+}
+
+void Graphics::FlushSprites()
+{
+  for (SpriteBatch &batch : _batches)
+  {
+    SDL_Texture *tex = batch.texture->GetTexture();
+    if (!tex)
+      continue;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    float tw = float(batch.texture->GetWidth());
+    float th = float(batch.texture->GetHeight());
+    _vertices.clear();
+    for (unsigned i = batch.first; i < batch.first + batch.count; ++i)
+    {
+      const SpriteQuad &q = _quads[i];
+      float hw = q.dst.w / 2.0f;
+      float hh = q.dst.h / 2.0f;
+      float cx = q.dst.x + hw;
+      float cy = q.dst.y + hh;
+      float c = float(std::cos(q.angle));
+      float s = float(std::sin(q.angle));
+      float u0 = q.src.x / tw;
+      float v0 = q.src.y / th;
+      float u1 = (q.src.x + q.src.w) / tw;
+      float v1 = (q.src.y + q.src.h) / th;
+      const float corners[4][4] = {{-hw, -hh, u0, v0}, {hw, -hh, u1, v0}, {hw, hh, u1, v1}, {-hw, hh, u0, v1}};
+      for (const float *k : corners)
+        _vertices.push_back(SDL_Vertex{{cx + k[0] * c - k[1] * s, cy + k[0] * s + k[1] * c}, {0xFF, 0xFF, 0xFF, 0xFF}, {k[2], k[3]}});
+    }
+    while (_indices.size() < batch.count * 6)
+    {
+      int v = int(_indices.size() / 6 * 4);
+      _indices.insert(_indices.end(), {v, v + 1, v + 2, v + 2, v + 3, v});
+    }
+    SDL_RenderGeometry(_renderer, tex, _vertices.data(), int(_vertices.size()), _indices.data(), int(batch.count * 6));
+    ++_spriteDrawCalls;
+#else
+    for (unsigned i = batch.first; i < batch.first + batch.count; ++i)
+    {
+      const SpriteQuad &q = _quads[i];
+      if (q.angle == 0.0)
+        SDL_RenderCopy(_renderer, tex, &q.src, &q.dst);
+      else
+        SDL_RenderCopyEx(_renderer, tex, &q.src, &q.dst, (q.angle / M_PI) * 180.0, NULL, SDL_FLIP_NONE);
+      ++_spriteDrawCalls;
+    }
+#endif
+  }
+  _quads.clear();
+  _batches.clear();
+}
+
 void Graphics::DrawText(UI::Text *text)
 {
+  if (InParallelUpdate())
+  {
+    Defer([this, text]() { DrawText(text); });
+    return;
+  }
+  Transform::Transform::DrawScope interpolated;
+  FlushSprites();
   if (text && text->GetTexture())
   {
     SDL_Rect rect = text->GetRect();
@@ -881,6 +1061,13 @@ void Graphics::DrawText(UI::Text *text)
 
 void Graphics::DrawText(UI::Text *text, SDL_Rect clip)
 {
+  if (InParallelUpdate())
+  {
+    Defer([this, text, clip]() { DrawText(text, clip); });
+    return;
+  }
+  Transform::Transform::DrawScope interpolated;
+  FlushSprites();
   if (text && text->GetTexture())
   {
     SDL_Rect rect = text->GetRect();
@@ -937,6 +1124,9 @@ void Graphics::PopulateDebugger()
   ImGui::Text("Window: 0x%p", _window);
   ImGui::Text("Surface: 0x%p", _surface);
   ImGui::Text("Renderer: 0x%p", _renderer);
+  ImGui::Text("Cached textures: %u", _textureCache.Count());
+  ImGui::Text("Sprites drawn: %u", _spriteCount);
+  ImGui::Text("Sprite draw calls: %u", _spriteDrawCalls);
   ImGui::Text("Background Red: 0x%x", _background.Red());
   ImGui::Text("Background Green: 0x%x", _background.Green());
   ImGui::Text("Background Blue: 0x%x", _background.Blue());
@@ -946,41 +1136,193 @@ void Graphics::PopulateDebugger()
 
 /////////////////////////////////////////////////////////
 
-Sprite::Sprite(std::string path, Object *parent, std::string name)
-    : Object(parent, name), _path(path), _surface(nullptr), _tex(nullptr)
+Texture::Texture(std::string path)
+    : _path(path), _surface(nullptr), _tex(nullptr), _renderer(nullptr), _width(0), _height(0)
+{
+}
+
+Texture::~Texture()
+{
+  Unload();
+  if (_surface)
+  {
+    SDL_FreeSurface(_surface);
+    _surface = nullptr;
+  }
+}
+
+bool Texture::Load()
 {
-  if (path.substr(path.length() - 4) == ".bmp")
+  if (_surface)
+    return true;
+  if (_path.length() >= 4 && _path.substr(_path.length() - 4) == ".bmp")
   {
-    _surface = SDL_LoadBMP(path.c_str());
+    _surface = SDL_LoadBMP(_path.c_str());
     if (!_surface)
     {
       Log::Error("Unable to load BMP. SDL_Error: %s", SDL_GetError());
-      _valid = false;
-      return;
+      return false;
     }
   }
-  else if (path.substr(path.length() - 4) == ".png")
+  else if (_path.length() >= 4 && _path.substr(_path.length() - 4) == ".png")
   {
-    _surface = IMG_Load(path.c_str());
+    _surface = IMG_Load(_path.c_str());
     if (!_surface)
     {
       Log::Error("Unable to load PNG. IMG_Error: %s", IMG_GetError());
-      _valid = false;
-      return;
+      return false;
     }
   }
   else
   {
-    Log::Error("Unknown extension of path: %s", path);
+    Log::Error("Unknown extension of path: %s", _path.c_str());
+    return false;
+  }
+  _width = _surface->w;
+  _height = _surface->h;
+  return true;
+}
+
+bool Texture::Upload(SDL_Renderer *renderer)
+{
+  if (_tex && _renderer == renderer)
+    return true;
+  if (Object::Object::InParallelUpdate())
+  {
+    // The Texture may be released by the time deferred work runs, so only a weak reference is kept
+    std::weak_ptr<Texture> texture = shared_from_this();
+    Object::Object::Defer([texture, renderer]() {
+      std::shared_ptr<Texture> t = texture.lock();
+      if (t)
+        t->Upload(renderer);
+    });
+    return true;
+  }
+  Unload();
+  if (!Load())
+    return false;
+  _tex = SDL_CreateTextureFromSurface(renderer, _surface);
+  if (!_tex)
+  {
+    Log::Error("Unable to generate texture for %s! SDL_Error: %s", _path.c_str(), SDL_GetError());
+    return false;
+  }
+  SDL_SetTextureBlendMode(_tex, SDL_BLENDMODE_BLEND);
+  _renderer = renderer;
+  SDL_FreeSurface(_surface);
+  _surface = nullptr;
+  return true;
+}
+
+void Texture::Unload()
+{
+  if (_tex)
+  {
+    SDL_DestroyTexture(_tex);
+    _tex = nullptr;
+  }
+  _renderer = nullptr;
+}
+
+const std::string &Texture::GetPath() const
+{
+  return _path;
+}
+
+SDL_Surface *Texture::GetSurface()
+{
+  return _surface;
+}
+
+SDL_Texture *Texture::GetTexture()
+{
+  return _tex;
+}
+
+int Texture::GetWidth() const
+{
+  return _width;
+}
+
+int Texture::GetHeight() const
+{
+  return _height;
+}
+
+/////////////////////////////////////////////////////////
+
+std::shared_ptr<Texture> TextureCache::Get(std::string path)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  std::map<std::string, std::weak_ptr<Texture>>::iterator it = _textures.find(path);
+  if (it != _textures.end())
+  {
+    std::shared_ptr<Texture> texture = it->second.lock();
+    if (texture)
+      return texture;
+    _textures.erase(it);
+  }
+  std::shared_ptr<Texture> texture = std::make_shared<Texture>(path);
+  if (!texture->Load())
+    return nullptr;
+  Graphics *gfx = Graphics::Get();
+  if (gfx && gfx->GetRenderer())
+    texture->Upload(gfx->GetRenderer());
+  _textures[path] = texture;
+  return texture;
+}
+
+void TextureCache::Unload()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  for (std::pair<const std::string, std::weak_ptr<Texture>> &it : _textures)
+  {
+    std::shared_ptr<Texture> texture = it.second.lock();
+    if (texture)
+      texture->Unload();
+  }
+}
+
+unsigned TextureCache::Count()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  unsigned count = 0;
+  for (std::pair<const std::string, std::weak_ptr<Texture>> &it : _textures)
+    if (!it.second.expired())
+      ++count;
+  return count;
+}
+
+/////////////////////////////////////////////////////////
+
+Sprite::Sprite(std::string path, Object *parent, std::string name)
+    : Object(parent, name), _path(path), _registryEntry(this), _transformComponent(this)
+{
+  _draws = true;
+  _texture = Graphics::GetTextureCache().Get(path);
+  if (!_texture)
+  {
     _valid = false;
     return;
   }
   GetRect().x = 0;
   GetRect().y = 0;
-  GetRect().w = _surface->w;
-  GetRect().h = _surface->h;
+  GetRect().w = _texture->GetWidth();
+  GetRect().h = _texture->GetHeight();
   GenerateTexture();
-  CreateChild<Transform::Transform>();
+}
+
+Sprite::Sprite(const Sprite &other, Object *parent)
+    : Object(other, parent), _path(other._path), _texture(other._texture), _rect(other._rect), _registryEntry(this), _transformComponent(this)
+{
+  _transformComponent = other._transformComponent;
+  if (!_texture)
+    _valid = false;
+}
+
+Object::Object *Sprite::Clone(Object *parent) const
+{
+  return new Sprite(*this, parent);
 }
 
 Sprite::~Sprite()
@@ -990,16 +1332,9 @@ Sprite::~Sprite()
 
 void Sprite::End()
 {
-  if (_surface)
-  {
-    SDL_FreeSurface(_surface);
-    _surface = nullptr;
-  }
-  if (_tex)
-  {
-    SDL_DestroyTexture(_tex);
-    _tex = nullptr;
-  }
+  if (DeferEnd())
+    return;
+  _texture.reset();
   Object::End();
 }
 
@@ -1011,28 +1346,15 @@ void Sprite::SetParent(Object *parent)
 
 void Sprite::GenerateTexture()
 {
-  if (Valid() && _surface)
+  if (Valid() && _texture)
   {
-    if (_tex)
-    {
-      SDL_DestroyTexture(_tex);
-      _tex = nullptr;
-    }
     Engine::Engine *engine = Engine::Engine::Get();
     if (engine)
     {
       Graphics *gfx = Graphics::Get();
       if (gfx)
-      {
-        _tex = SDL_CreateTextureFromSurface(gfx->GetRenderer(), _surface);
-        if (!_tex)
-        {
-          Log::Error("%s was unable to generate texture! SDL_Error: %s", Name().c_str(), SDL_GetError());
-          return;
-        }
-        SDL_SetTextureBlendMode(_tex, SDL_BLENDMODE_BLEND);
-      }
-      else
+        _texture->Upload(gfx->GetRenderer());
+      else if (!engine->Headless())
         Log::Error("%s requires an ancestor Engine with child Graphics!", Name().c_str());
     }
     else
@@ -1050,7 +1372,7 @@ void Sprite::operator()()
       Graphics *gfx = Graphics::Get();
       if (gfx)
         gfx->DrawSprite(this);
-      else
+      else if (!engine->Headless())
         Log::Error("%s requires an ancestor Engine with child Graphics!", Name().c_str());
     }
     else
@@ -1065,11 +1387,16 @@ const std::string &Sprite::GetPath() const
 
 SDL_Surface *Sprite::GetSurface()
 {
-  return _surface;
+  return _texture ? _texture->GetSurface() : nullptr;
 }
 SDL_Texture *Sprite::GetTexture()
 {
-  return _tex;
+  return _texture ? _texture->GetTexture() : nullptr;
+}
+
+const std::shared_ptr<Texture> &Sprite::GetSharedTexture() const
+{
+  return _texture;
 }
 
 SDL_Rect &Sprite::GetRect()
@@ -1080,8 +1407,9 @@ SDL_Rect &Sprite::GetRect()
 void Sprite::PopulateDebugger()
 {
   ImGui::Text("Path: %s", _path.c_str());
-  ImGui::Text("Surface: 0x%p", _surface);
-  ImGui::Text("Texture: 0x%p", _tex);
+  ImGui::Text("Surface: 0x%p", GetSurface());
+  ImGui::Text("Texture: 0x%p", GetTexture());
+  ImGui::Text("Shared by: %ld", _texture.use_count());
   ImGui::Text("X Pos: %d", _rect.x);
   ImGui::Text("Y Pos: %d", _rect.y);
   ImGui::Text("Size: (%d, %d)", _rect.w, _rect.h);
@@ -1098,11 +1426,10 @@ UniformSpritesheet::UniformSpritesheet(Object *parent, std::string name)
 UniformSpritesheet::UniformSpritesheet(std::string path, unsigned frameCount, Object *parent, std::string name)
     : Sprite(path, parent, name), _frame({0, 0, 0, 0}), _framecount(frameCount)
 {
-  SDL_Surface *s = GetSurface();
-  if (s)
+  if (GetSharedTexture())
   {
-    _frame.w = s->w / frameCount;
-    _frame.h = s->h;
+    _frame.w = GetSharedTexture()->GetWidth() / frameCount;
+    _frame.h = GetSharedTexture()->GetHeight();
   }
 }
 
@@ -1118,6 +1445,16 @@ UniformSpritesheet::UniformSpritesheet(std::string path, unsigned frameWidth, un
   _frame.h = frameHeight;
 }
 
+UniformSpritesheet::UniformSpritesheet(const UniformSpritesheet &other, Object *parent)
+    : Sprite(other, parent), _frame(other._frame), _framecount(other._framecount)
+{
+}
+
+Object::Object *UniformSpritesheet::Clone(Object *parent) const
+{
+  return new UniformSpritesheet(*this, parent);
+}
+
 UniformSpritesheet::~UniformSpritesheet()
 {
 }
@@ -1132,7 +1469,7 @@ void UniformSpritesheet::operator()()
       Graphics *gfx = Graphics::Get();
       if (gfx)
         gfx->DrawSprite(this, GetClipRectangle(0));
-      else
+      else if (!engine->Headless())
         Log::Error("%s requires an ancestor Engine with child Graphics!", Name().c_str());
     }
     else
@@ -1148,9 +1485,9 @@ int UniformSpritesheet::GetFrameCount()
 
 SDL_Rect UniformSpritesheet::GetClipRectangle(int frame)
 {
-  if (frame < _framecount && _framecount >= 0)
+  if (frame < _framecount && _framecount >= 0 && GetSharedTexture())
   {
-    int hframes = GetSurface()->w / _frame.w;
+    int hframes = GetSharedTexture()->GetWidth() / _frame.w;
     return SDL_Rect{_frame.w * (frame % hframes), _frame.h * (frame / hframes), _frame.w, _frame.h};
   }
   return SDL_Rect{0, 0, 0, 0};
@@ -1172,10 +1509,24 @@ Animation::Animation(Object *parent, std::string name)
 }
 
 Animation::Animation(UniformSpritesheet *spritesheet, float frameDelay, Object *parent, std::string name)
-    : Object(parent, name), _currentFrame(0), _delay(frameDelay), _remainingDelay(_delay), _done(false)
+    : Object(parent, name), _currentFrame(0), _delay(frameDelay), _remainingDelay(_delay), _done(false), _registryEntry(this), _transformComponent(this)
 {
+  // Only the current frame's Sprite is drawn
+  _updatesOwnChildren = true;
+  _draws = true;
   AddChild(spritesheet);
-  CreateChild<Transform::Transform>();
+}
+
+Animation::Animation(const Animation &other, Object *parent)
+    : Object(other, parent), _currentFrame(other._currentFrame), _delay(other._delay), _remainingDelay(other._remainingDelay), _done(other._done),
+      _registryEntry(this), _transformComponent(this)
+{
+  _transformComponent = other._transformComponent;
+}
+
+Object::Object *Animation::Clone(Object *parent) const
+{
+  return new Animation(*this, parent);
 }
 
 Animation::~Animation()
@@ -1189,35 +1540,18 @@ void Animation::operator()()
   Engine::Engine *engine = Engine::Engine::Get();
   if (engine)
   {
-    Time::Time *time = engine->FindAncestorOfType<Time::Time>();
     if (_done)
       _done = false;
-    if (_delay > 0)
-    {
-      float dt;
-      if (time)
-        dt = time->DeltaTime();
-      else
-        dt = 1 / 60.0f;
-
-      _remainingDelay += dt;
-      while (_remainingDelay >= _delay)
-      {
-        _remainingDelay -= _delay;
-        if (++_currentFrame >= GetFrameCount())
-        {
-          _currentFrame = 0;
-          _done = true;
-        }
-      }
-    }
+    if (engine->FixedTimestep() <= 0.0 && UpdateDue() && !Sleeping())
+      Step(UpdateDeltaTime());
 
     Graphics *gfx = Graphics::Get();
     if (gfx && _currentFrame >= 0)
     {
       int f = _currentFrame;
-      for (Object *child : _children)
+      for (unsigned i = 0; i < _children.size(); ++i)
       {
+        Object *child = _children[i];
         if (dynamic_cast<UniformSpritesheet *>(child))
         {
           if (f >= 0)
@@ -1248,18 +1582,15 @@ void Animation::operator()()
         }
         else
           (*child)();
-
-        if (!child->Valid())
-        {
-          RemoveChild(child);
-          delete child;
-        }
       }
     }
     else
     {
       if (!gfx)
-        Log::Error("%s requires an ancestor Engine with child Graphics!", Name().c_str());
+      {
+        if (!engine->Headless())
+          Log::Error("%s requires an ancestor Engine with child Graphics!", Name().c_str());
+      }
       else
         Log::Error("%s's current frame is less than 0! (%d)", Name().c_str(), _currentFrame);
     }
@@ -1268,6 +1599,25 @@ void Animation::operator()()
     Log::Error("%s requires an ancestor Engine with child Graphics!", Name().c_str());
 }
 
+void Animation::Step(double dt)
+{
+  if (_delay > 0)
+  {
+    _remainingDelay += dt;
+    while (_remainingDelay >= _delay)
+    {
+      _remainingDelay -= _delay;
+      if (++_currentFrame >= GetFrameCount())
+      {
+        _currentFrame = 0;
+        _done = true;
+      }
+      // A playing Animation isn't idle
+      Wake();
+    }
+  }
+}
+
 int Animation::GetFrameCount()
 {
   int count = 0;
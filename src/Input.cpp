@@ -4,7 +4,7 @@
 #include "Time.hpp"
 #include "Engine.hpp"
 #include <cmath>
-#include <map>
+#include <vector>
 #include "imgui.h"
 
 #undef __INPUT_CPP
@@ -23,6 +23,16 @@ Axis::Axis(SDL_Keycode positive, SDL_Keycode negative, float gravity, float weig
 {
 }
 
+Axis::Axis(const Axis &other, Object *parent)
+    : Object(other, parent), _pos(other._pos), _neg(other._neg), _gravity(other._gravity), _weight(other._weight), _value(0)
+{
+}
+
+Object::Object *Axis::Clone(Object *parent) const
+{
+  return new Axis(*this, parent);
+}
+
 void Axis::operator()()
 {
   Time::Time *time = nullptr;
@@ -59,18 +69,51 @@ void Axis::PopulateDebugger()
   Object::PopulateDebugger();
 }
 
-std::map<SDL_Keycode, Key> keys;
+/// \brief State of every key indexed by scancode
+///        keys[SDL_SCANCODE_UNKNOWN] is never changed and stands in for keys that can't be mapped
+Key keys[SDL_NUM_SCANCODES];
+/// \brief Scancodes of the keys producing each character keycode below 128
+///        Depends on the keyboard layout, so it's filled in from key events and lookups as they happen
+SDL_Scancode characterScancodes[128];
+/// \brief Scancodes of the Keys with pressed or released set since ClearKeyEdges was last called
+std::vector<SDL_Scancode> changedKeys;
 
 Key::Key()
     : held(false), pressed(false), released(false)
 {
 }
 
+/// \brief Maps a keycode to the scancode of the key that produces it
+/// \param k Keycode to map
+/// \return Scancode, or SDL_SCANCODE_UNKNOWN if no key produces k
+static SDL_Scancode ToScancode(SDL_Keycode k)
+{
+  if (k & SDLK_SCANCODE_MASK)
+  {
+    SDL_Keycode s = k & ~SDLK_SCANCODE_MASK;
+    return s < SDL_NUM_SCANCODES ? static_cast<SDL_Scancode>(s) : SDL_SCANCODE_UNKNOWN;
+  }
+  if (k > 0 && k < 128)
+  {
+    if (characterScancodes[k] == SDL_SCANCODE_UNKNOWN)
+      characterScancodes[k] = SDL_GetScancodeFromKey(k);
+    return characterScancodes[k];
+  }
+  if (k > 0)
+    return SDL_GetScancodeFromKey(k);
+  return SDL_SCANCODE_UNKNOWN;
+}
+
 Key &GetKey(SDL_Keycode k)
 {
-  if (keys.find(k) == keys.end())
-    keys[k] = Key();
-  return keys[k];
+  return keys[ToScancode(k)];
+}
+
+Key &GetKey(SDL_Scancode s)
+{
+  if (s > SDL_SCANCODE_UNKNOWN && s < SDL_NUM_SCANCODES)
+    return keys[s];
+  return keys[SDL_SCANCODE_UNKNOWN];
 }
 
 bool KeyHeld(SDL_Keycode k)
@@ -78,16 +121,65 @@ bool KeyHeld(SDL_Keycode k)
   return GetKey(k).held;
 }
 
+bool KeyHeld(SDL_Scancode s)
+{
+  return GetKey(s).held;
+}
+
 bool KeyPressed(SDL_Keycode k)
 {
   return GetKey(k).pressed;
 }
 
+bool KeyPressed(SDL_Scancode s)
+{
+  return GetKey(s).pressed;
+}
+
 bool KeyReleased(SDL_Keycode k)
 {
   return GetKey(k).released;
 }
 
+bool KeyReleased(SDL_Scancode s)
+{
+  return GetKey(s).released;
+}
+
+bool HandleKeyEvent(const SDL_KeyboardEvent &event)
+{
+  SDL_Scancode s = event.keysym.scancode;
+  if (s <= SDL_SCANCODE_UNKNOWN || s >= SDL_NUM_SCANCODES)
+    return false;
+  if (event.keysym.sym > 0 && event.keysym.sym < 128)
+    characterScancodes[event.keysym.sym] = s;
+  Key &k = keys[s];
+  if (event.type == SDL_KEYDOWN && !k.held)
+  {
+    k.pressed = true;
+    k.held = true;
+  }
+  else if (event.type == SDL_KEYUP && k.held)
+  {
+    k.held = false;
+    k.released = true;
+  }
+  else
+    return false;
+  changedKeys.push_back(s);
+  return true;
+}
+
+void ClearKeyEdges()
+{
+  for (SDL_Scancode s : changedKeys)
+  {
+    keys[s].pressed = false;
+    keys[s].released = false;
+  }
+  changedKeys.clear();
+}
+
 Mouse mouse;
 
 Mouse &GetMouse()
@@ -0,0 +1,235 @@
+#define __JOBS_CPP
+
+#include "Jobs.hpp"
+#include "Log.hpp"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#undef __JOBS_CPP
+
+namespace Aspen
+{
+namespace Jobs
+{
+/// \brief Queued job
+class Job
+{
+public:
+  /// \brief Function to run
+  std::function<void()> fn;
+  /// \brief Group the job belongs to
+  Group *group;
+};
+
+/// \brief Queue of jobs owned by a single thread
+///        The owner pushes and pops at the back while thieves take from the front
+class Queue
+{
+public:
+  /// \brief Guards jobs
+  std::mutex mutex;
+  /// \brief Queued jobs
+  std::deque<Job> jobs;
+};
+
+/// \brief Creates the queue list with only the shared queue in it
+/// \return New queue list
+static std::vector<std::unique_ptr<Queue>> CreateQueues()
+{
+  std::vector<std::unique_ptr<Queue>> queues;
+  queues.emplace_back(new Queue());
+  return queues;
+}
+
+/// \brief Queue of every worker, followed by the queue shared by every other thread
+static std::vector<std::unique_ptr<Queue>> _queues = CreateQueues();
+/// \brief Worker threads
+static std::vector<std::thread> _workers;
+/// \brief Determines if the workers should keep running
+static std::atomic<bool> _running(false);
+/// \brief Number of jobs in all queues
+static std::atomic<unsigned> _queued(0);
+/// \brief Guards sleeping on _wake
+static std::mutex _sleepMutex;
+/// \brief Wakes idle workers when jobs are queued
+static std::condition_variable _wake;
+/// \brief Guards Start and Stop
+static std::mutex _startMutex;
+/// \brief Index of this thread's queue
+///        -1 for threads that aren't workers
+static thread_local int _queueIndex = -1;
+
+/// \brief Gets the queue of the calling thread
+/// \return Worker's own queue, or the shared queue for other threads
+static Queue &LocalQueue()
+{
+  return _queueIndex >= 0 ? *_queues[_queueIndex] : *_queues.back();
+}
+
+/// \brief Takes a job from the back of the calling thread's queue or the front of any other queue
+/// \param job Job to fill out
+/// \return True if a job was taken
+static bool Take(Job &job)
+{
+  unsigned count = unsigned(_queues.size());
+  unsigned own = _queueIndex >= 0 ? unsigned(_queueIndex) : count - 1;
+  {
+    Queue &q = LocalQueue();
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (!q.jobs.empty())
+    {
+      job = std::move(q.jobs.back());
+      q.jobs.pop_back();
+      --_queued;
+      return true;
+    }
+  }
+  for (unsigned i = 1; i < count; ++i)
+  {
+    Queue *q = _queues[(own + i) % count].get();
+    std::lock_guard<std::mutex> lock(q->mutex);
+    if (!q->jobs.empty())
+    {
+      job = std::move(q->jobs.front());
+      q->jobs.pop_front();
+      --_queued;
+      return true;
+    }
+  }
+  return false;
+}
+
+/// \brief Runs a single queued job if one can be taken
+/// \return True if a job was run
+static bool RunOne()
+{
+  Job job;
+  if (!Take(job))
+    return false;
+  job.fn();
+  job.group->Finish();
+  return true;
+}
+
+/// \brief Worker thread loop
+/// \param index Index of the worker's queue
+static void Work(int index)
+{
+  _queueIndex = index;
+  while (_running)
+  {
+    if (RunOne())
+      continue;
+    std::unique_lock<std::mutex> lock(_sleepMutex);
+    _wake.wait(lock, []() { return _queued > 0 || !_running; });
+  }
+}
+
+/// \brief Stops the workers when the program exits
+class Stopper
+{
+public:
+  /// \brief Destructor
+  ~Stopper()
+  {
+    Stop();
+  }
+};
+/// \brief Stops the workers when the program exits
+///        Defined after everything the workers use so it's destroyed first
+static Stopper _stopper;
+
+void Start(unsigned threads)
+{
+  std::lock_guard<std::mutex> lock(_startMutex);
+  if (_running)
+    return;
+  if (threads == 0)
+  {
+    unsigned hardware = std::thread::hardware_concurrency();
+    threads = hardware > 1 ? hardware - 1 : 0;
+  }
+  // The shared queue stays last and keeps any jobs queued while the workers were stopped
+  std::unique_ptr<Queue> shared = std::move(_queues.back());
+  _queues.clear();
+  for (unsigned i = 0; i < threads; ++i)
+    _queues.emplace_back(new Queue());
+  _queues.push_back(std::move(shared));
+  _running = true;
+  for (unsigned i = 0; i < threads; ++i)
+    _workers.emplace_back(Work, int(i));
+  Log::Info("Started %u job worker threads", threads);
+}
+
+void Stop()
+{
+  std::lock_guard<std::mutex> lock(_startMutex);
+  if (!_running)
+    return;
+  {
+    std::lock_guard<std::mutex> sleepLock(_sleepMutex);
+    _running = false;
+  }
+  _wake.notify_all();
+  for (std::thread &worker : _workers)
+    worker.join();
+  _workers.clear();
+  // Leftover jobs move to the shared queue so a Group can still finish them
+  std::unique_ptr<Queue> shared = std::move(_queues.back());
+  for (unsigned i = 0; i + 1 < _queues.size(); ++i)
+    for (Job &job : _queues[i]->jobs)
+      shared->jobs.push_back(std::move(job));
+  _queues.clear();
+  _queues.push_back(std::move(shared));
+}
+
+unsigned WorkerCount()
+{
+  return unsigned(_workers.size());
+}
+
+Group::Group()
+    : _pending(0)
+{
+}
+
+Group::~Group()
+{
+  Wait();
+}
+
+void Group::Run(std::function<void()> job)
+{
+  if (!_running)
+    Start();
+  ++_pending;
+  {
+    Queue &q = LocalQueue();
+    std::lock_guard<std::mutex> lock(q.mutex);
+    q.jobs.push_back(Job{std::move(job), this});
+    ++_queued;
+  }
+  // Taking the lock orders this with a worker checking _queued before it sleeps
+  {
+    std::lock_guard<std::mutex> lock(_sleepMutex);
+  }
+  _wake.notify_one();
+}
+
+void Group::Wait()
+{
+  while (_pending > 0)
+    if (!RunOne())
+      std::this_thread::yield();
+}
+
+void Group::Finish()
+{
+  --_pending;
+}
+} // namespace Jobs
+} // namespace Aspen
@@ -5,6 +5,11 @@
 #include <fstream>
 #include <iomanip>
 #include <stdarg.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
 
 #undef __LOG_CPP
 
@@ -12,8 +17,220 @@ namespace Aspen
 {
 namespace Log
 {
-int Log::_line = 0;
+const unsigned QUEUE_SIZE = 1024;
+/// \brief Longest message that is logged, including the prefix, suffix and terminating null
+static const unsigned MESSAGE_LENGTH = 640;
+
+std::atomic<int> Log::_line(0);
 std::fstream Log::_file;
+/// \brief Guards _file while it is being written to or reopened
+static std::mutex _fileMutex;
+
+/// \brief Queued message
+class Message
+{
+public:
+  /// \brief Position in the queue this slot is ready for
+  ///        Equal to the position when it's free to write to, position + 1 once it's been written
+  std::atomic<unsigned long long> sequence;
+  /// \brief Seconds since logging started when the message was logged
+  double time;
+  /// \brief Formatted message including the prefix and suffix
+  char text[MESSAGE_LENGTH];
+};
+
+/// \brief Bounded lock-free queue of messages written by a background thread
+///        Any number of threads may push, only the writer thread pops
+class AsyncWriter
+{
+public:
+  /// \brief Queued messages
+  Message messages[QUEUE_SIZE];
+  /// \brief Next position to push to
+  std::atomic<unsigned long long> head;
+  /// \brief Next position to pop from
+  std::atomic<unsigned long long> tail;
+  /// \brief Number of messages dropped since the writer last reported them
+  std::atomic<unsigned long long> dropped;
+  /// \brief Total number of messages dropped
+  std::atomic<unsigned long long> totalDropped;
+  /// \brief True while operator() should push messages instead of writing them
+  std::atomic<bool> enabled;
+  /// \brief True while the writer thread should keep running
+  std::atomic<bool> running;
+  /// \brief Number of operator() calls that saw enabled and may still be pushing
+  ///        Stop waits for these before the last Drain so their messages aren't lost
+  std::atomic<unsigned> pushing;
+  /// \brief True while the writer thread is waiting for messages
+  ///        Pushes only lock wakeMutex to wake it while this is set
+  std::atomic<bool> waiting;
+  /// \brief Guards the writer thread's wait
+  std::mutex wakeMutex;
+  /// \brief Wakes the writer thread once messages are queued or it's stopped
+  std::condition_variable wake;
+  /// \brief What to do with messages pushed while the queue is full
+  OVERFLOW_POLICY policy;
+  /// \brief Time logging started
+  std::chrono::steady_clock::time_point start;
+  /// \brief Writer thread
+  std::thread thread;
+
+  /// \brief Constructor
+  AsyncWriter()
+      : head(0), tail(0), dropped(0), totalDropped(0), enabled(false), running(false), pushing(0), waiting(false),
+        policy(DROP), start(std::chrono::steady_clock::now())
+  {
+    for (unsigned i = 0; i < QUEUE_SIZE; ++i)
+      messages[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  /// \brief Destructor
+  ///        Writes anything still queued
+  ~AsyncWriter()
+  {
+    Stop();
+  }
+
+  /// \brief Starts the writer thread
+  void Start()
+  {
+    if (running)
+      return;
+    running = true;
+    thread = std::thread(&AsyncWriter::Run, this);
+    enabled = true;
+  }
+  /// \brief Writes every queued message and stops the writer thread
+  void Stop()
+  {
+    if (!running)
+      return;
+    enabled = false;
+    // Pushes that saw enabled before it was cleared finish before the last Drain
+    while (pushing > 0)
+      std::this_thread::yield();
+    {
+      std::lock_guard<std::mutex> lock(wakeMutex);
+      running = false;
+    }
+    wake.notify_one();
+    thread.join();
+    Drain();
+  }
+
+  /// \brief Pushes a message onto the queue if asynchronous logging hasn't been stopped
+  /// \param text Formatted message
+  /// \return False if the caller has to write the message itself
+  bool TryPush(const char *text)
+  {
+    ++pushing;
+    bool pushed = enabled;
+    if (pushed)
+      Push(text);
+    --pushing;
+    return pushed;
+  }
+
+  /// \brief Pushes a message onto the queue
+  /// \param text Formatted message
+  void Push(const char *text)
+  {
+    unsigned long long pos = head.load(std::memory_order_relaxed);
+    Message *m;
+    for (;;)
+    {
+      m = &messages[pos % QUEUE_SIZE];
+      unsigned long long seq = m->sequence.load(std::memory_order_acquire);
+      if (seq == pos)
+      {
+        if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (seq < pos)
+      {
+        if (policy == DROP)
+        {
+          ++dropped;
+          ++totalDropped;
+          return;
+        }
+        std::this_thread::yield();
+        pos = head.load(std::memory_order_relaxed);
+      }
+      else
+        pos = head.load(std::memory_order_relaxed);
+    }
+    m->time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::strncpy(m->text, text, MESSAGE_LENGTH - 1);
+    m->text[MESSAGE_LENGTH - 1] = '\0';
+    m->sequence.store(pos + 1, std::memory_order_release);
+    // Pairs with the fence in Run, so either the writer sees this message before waiting or this sees it waiting
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting.load(std::memory_order_relaxed))
+    {
+      std::lock_guard<std::mutex> lock(wakeMutex);
+      wake.notify_one();
+    }
+  }
+
+  /// \brief Determines if a message is ready to be written
+  /// \return True if the next message has been pushed
+  bool Pending()
+  {
+    unsigned long long pos = tail.load(std::memory_order_relaxed);
+    return messages[pos % QUEUE_SIZE].sequence.load(std::memory_order_acquire) == pos + 1;
+  }
+
+  /// \brief Writes everything currently queued in one batch
+  /// \return True if anything was written
+  bool Drain()
+  {
+    std::stringstream batch;
+    unsigned long long pos = tail.load(std::memory_order_relaxed);
+    for (;;)
+    {
+      Message &m = messages[pos % QUEUE_SIZE];
+      if (m.sequence.load(std::memory_order_acquire) != pos + 1)
+        break;
+      batch << "[" << std::setw(4) << std::setfill('0') << (Log::NextLine()) << std::setw(0) << "] "
+            << "[" << std::fixed << std::setprecision(3) << m.time << "] " << m.text << '\n';
+      m.sequence.store(pos + QUEUE_SIZE, std::memory_order_release);
+      tail.store(++pos, std::memory_order_release);
+    }
+    unsigned long long d = dropped.exchange(0);
+    if (d)
+      batch << "[" << std::setw(4) << std::setfill('0') << (Log::NextLine()) << std::setw(0) << "] "
+            << d << " log messages were dropped because the queue was full" << '\n';
+    std::string out = batch.str();
+    if (out.empty())
+      return false;
+    std::cout << out << std::flush;
+    std::lock_guard<std::mutex> lock(_fileMutex);
+    if (Log::_file.is_open())
+      Log::_file << out << std::flush;
+    return true;
+  }
+
+  /// \brief Writer thread loop
+  ///        Sleeps until a push or Stop wakes it
+  void Run()
+  {
+    while (running)
+    {
+      if (Drain())
+        continue;
+      std::unique_lock<std::mutex> lock(wakeMutex);
+      waiting = true;
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      wake.wait(lock, [this]() { return !running || Pending(); });
+      waiting = false;
+    }
+    Drain();
+  }
+};
+
+/// \brief Asynchronous logging state
+///        Defined after Log::_file so it's destroyed and drained first
+static AsyncWriter _async;
 
 Log::Log(std::string prefix, std::string suffix, bool print)
     : _pre(prefix), _suf(suffix), _print(print) {}
@@ -25,11 +242,20 @@ void Log::operator()(const char *format, ...)
   char buffer[512];
   va_list args;
   va_start(args, format);
-  vsprintf(buffer, format, args);
+  vsnprintf(buffer, sizeof(buffer), format, args);
   va_end(args);
+  if (_async.enabled.load(std::memory_order_relaxed))
+  {
+    char message[MESSAGE_LENGTH];
+    snprintf(message, sizeof(message), "%s%s%s", _pre.c_str(), buffer, _suf.c_str());
+    // Written below instead if logging stopped being asynchronous in the meantime
+    if (_async.TryPush(message))
+      return;
+  }
   std::stringstream output;
-  output << "[" << std::setw(4) << std::setfill('0') << (_line++) << std::setw(0) << "] " << _pre << buffer << _suf << std::endl;
+  output << "[" << std::setw(4) << std::setfill('0') << NextLine() << std::setw(0) << "] " << _pre << buffer << _suf << std::endl;
   std::cout << output.str();
+  std::lock_guard<std::mutex> lock(_fileMutex);
   if (_file.is_open())
     _file << output.str();
 }
@@ -39,12 +265,49 @@ void Log::TogglePrint()
   _print = !_print;
 }
 
+int Log::NextLine()
+{
+  return _line++;
+}
+
 bool Log::SetFile(std::string path)
 {
+  Flush();
+  std::lock_guard<std::mutex> lock(_fileMutex);
   _file.open(path.c_str(), std::ios_base::out | std::ios_base::app | std::ios_base::ate);
   return _file.is_open();
 }
 
+bool Log::Async()
+{
+  return _async.enabled;
+}
+
+void Log::Async(bool async, OVERFLOW_POLICY policy)
+{
+  if (async)
+  {
+    _async.policy = policy;
+    _async.Start();
+  }
+  else
+    _async.Stop();
+}
+
+void Log::Flush()
+{
+  if (!_async.enabled)
+    return;
+  unsigned long long target = _async.head.load();
+  while (_async.tail.load(std::memory_order_acquire) < target)
+    std::this_thread::yield();
+}
+
+unsigned long long Log::Dropped()
+{
+  return _async.totalDropped;
+}
+
 #ifdef __WIN32
 #ifdef __DEBUG
 Log Debug = Log("DBG: ");
@@ -4,8 +4,14 @@
 #include "Engine.hpp"
 #include "Transform.hpp"
 #include "Physics.hpp"
+#include "Profiler.hpp"
+#include "Jobs.hpp"
 #include <algorithm>
+#include <atomic>
 #include <iomanip>
+#include <typeinfo>
+#include <mutex>
+#include <unordered_map>
 #include "imgui.h"
 
 #undef __OBJECT_CPP
@@ -14,19 +20,547 @@ namespace Aspen
 {
 namespace Object
 {
-int Object::_count = 0;
+std::atomic<int> Object::_count(0);
+
+/// \brief Objects with ended children waiting for DestroyEnded
+static std::vector<Object *> _withEndedChildren;
+/// \brief Guards _withEndedChildren
+static std::mutex _withEndedChildrenMutex;
+/// \brief Slot in the handle table
+///        object and generation are atomic since handles are resolved by parallel update jobs without locking
+class HandleTableSlot
+{
+public:
+  /// \brief Object using the slot
+  ///        nullptr if the slot is free
+  std::atomic<Object *> object;
+  /// \brief Number of times the slot has been freed
+  std::atomic<unsigned> generation;
+  /// \brief Next free slot when this one is free
+  unsigned nextFree;
+};
+/// \brief Number of slots in each block of the handle table
+static const unsigned HANDLE_BLOCK_SIZE = 4096;
+/// \brief Most blocks the handle table can have
+static const unsigned HANDLE_BLOCK_COUNT = 4096;
+/// \brief Blocks of the handle table
+///        Blocks never move once allocated so slots can be read without locking
+static HandleTableSlot *_handleBlocks[HANDLE_BLOCK_COUNT];
+/// \brief Number of slots ever handed out
+static unsigned _handleSlotCount = 0;
+/// \brief Most recently freed slot
+static unsigned _handleFree = HANDLE_NONE;
+/// \brief Guards _handleBlocks, _handleSlotCount, and _handleFree
+static std::mutex _handleMutex;
+
+/// \brief Gets a slot of the handle table
+/// \param slot Slot index
+/// \return Slot
+static HandleTableSlot &GetHandleSlot(unsigned slot)
+{
+  return _handleBlocks[slot / HANDLE_BLOCK_SIZE][slot % HANDLE_BLOCK_SIZE];
+}
+
+/// \brief Gives an Object a slot in the handle table
+///        Reuses the most recently freed slot if there is one
+/// \param object Object to give a slot
+/// \return Slot index
+static unsigned AllocateHandleSlot(Object *object)
+{
+  std::lock_guard<std::mutex> lock(_handleMutex);
+  unsigned slot = _handleFree;
+  if (slot != HANDLE_NONE)
+    _handleFree = GetHandleSlot(slot).nextFree;
+  else
+  {
+    if (_handleSlotCount == HANDLE_BLOCK_SIZE * HANDLE_BLOCK_COUNT)
+    {
+      Log::Error("The handle table is full, so handles to %s won't resolve", object->Name().c_str());
+      return HANDLE_NONE;
+    }
+    slot = _handleSlotCount++;
+    if (!_handleBlocks[slot / HANDLE_BLOCK_SIZE])
+      _handleBlocks[slot / HANDLE_BLOCK_SIZE] = new HandleTableSlot[HANDLE_BLOCK_SIZE]();
+  }
+  GetHandleSlot(slot).object.store(object, std::memory_order_release);
+  return slot;
+}
+
+/// \brief Frees a slot in the handle table
+///        Bumps its generation so existing handles to it stop resolving
+/// \param slot Slot index
+static void FreeHandleSlot(unsigned slot)
+{
+  if (slot == HANDLE_NONE)
+    return;
+  std::lock_guard<std::mutex> lock(_handleMutex);
+  HandleTableSlot &s = GetHandleSlot(slot);
+  s.object.store(nullptr, std::memory_order_relaxed);
+  s.generation.fetch_add(1, std::memory_order_release);
+  s.nextFree = _handleFree;
+  _handleFree = slot;
+}
+
+Object *ResolveHandle(unsigned slot, unsigned generation)
+{
+  HandleTableSlot &s = GetHandleSlot(slot);
+  if (s.generation.load(std::memory_order_acquire) != generation)
+    return nullptr;
+  Object *o = s.object.load(std::memory_order_acquire);
+  // The slot may have been freed between the two loads
+  if (!o || s.generation.load(std::memory_order_acquire) != generation || !o->Valid())
+    return nullptr;
+  return o;
+}
+
+/// \brief Number of names in each block of the name table
+static const unsigned NAME_BLOCK_SIZE = 1024;
+/// \brief Most blocks the name table can have
+static const unsigned NAME_BLOCK_COUNT = 4096;
+/// \brief Blocks of the name table
+///        Blocks never move once allocated so names can be read without locking
+static std::string *_nameBlocks[NAME_BLOCK_COUNT];
+/// \brief Number of names in the name table
+static unsigned _nameCount = 0;
+/// \brief Guards _nameBlocks, _nameCount, and NameIndex
+static std::mutex _nameMutex;
+
+/// \brief Gets the index from names to their IDs
+///        Never destroyed so Objects can still be named while other statics are being destroyed
+/// \return Name index
+static std::unordered_map<std::string, unsigned> &NameIndex()
+{
+  static std::unordered_map<std::string, unsigned> *index = new std::unordered_map<std::string, unsigned>();
+  return *index;
+}
+
+/// \brief Number of Object::operator() calls currently running on this thread
+///        Ended Objects are only destroyed once the outermost one finishes
+static thread_local unsigned _updateDepth = 0;
+
+/// \brief Number of frames kept in _frameClock
+///        Must be larger than Object::MAX_UPDATE_INTERVAL
+static const unsigned FRAME_CLOCK_SIZE = 256;
+/// \brief Number of frames counted by Object::AdvanceFrame
+static unsigned long long _frame = 0;
+/// \brief Total length in seconds of every frame up to each of the last FRAME_CLOCK_SIZE frames
+///        Indexed by frame % FRAME_CLOCK_SIZE
+static double _frameClock[FRAME_CLOCK_SIZE] = {};
+/// \brief Offset the next update rate group of each interval is given
+static std::atomic<unsigned> _nextUpdateOffset[FRAME_CLOCK_SIZE];
+
+/// \brief Job updating a single child during a parallel update
+class ParallelJob
+{
+public:
+  /// \brief Child being updated
+  Object *root;
+  /// \brief Root of the whole tree being updated
+  Object *treeRoot;
+  /// \brief Functions deferred by the job, in the order they were deferred
+  std::vector<std::function<void()>> deferred;
+};
+/// \brief Parallel update job running on this thread
+static thread_local ParallelJob *_currentJob = nullptr;
+/// \brief Number of parallel updates whose jobs are running
+static std::atomic<unsigned> _parallelUpdates(0);
+
+/// \brief Incremented whenever an attached Object anywhere is added, removed, ended, activated, deactivated,
+///        put to sleep, woken, or moved to another update rate group
+///        TraversalCaches built at an older version are rebuilt before they're used
+static std::atomic<unsigned> _treeVersion(0);
+
+/// \brief Marks every TraversalCache as out of date
+static void TreeChanged()
+{
+  _treeVersion.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// \brief Number of idle frames before Objects with AutoSleep fall asleep
+static unsigned _sleepDelay = 60;
+
+/// \brief Object whose operator() is being run by an update pass on this thread
+///        Object::UpdateTree leaves its children to the pass instead of updating them itself
+static thread_local Object *_passObject = nullptr;
+/// \brief Set by Object::UpdateTree once _passObject has been updated and its children should be too
+static thread_local bool _passDescend = false;
+
+/// \brief Object whose children are being updated by an update pass walking the live tree
+class PassFrame
+{
+public:
+  /// \brief Object whose children are being updated
+  Object *parent;
+  /// \brief Index of the next child to update
+  unsigned index;
+};
+/// \brief Update passes walking the live tree on this thread
+///        Passes started while another is running use the frames above the outer pass's
+static thread_local std::vector<PassFrame> _passStack;
+
+/// \brief Index of an Object that isn't in a PhaseList
+static const unsigned PHASE_LIST_NONE = 0xFFFFFFFF;
+
+/// \brief Attached Objects taking part in a single phase
+///        Lets a phase be run without visiting every Object in the tree
+///        Objects are kept in tree pre-order, so parents run before their children and siblings in order
+class PhaseList
+{
+public:
+  /// \brief Listed Objects
+  ///        Removed Objects leave nullptr until the next compaction
+  std::vector<Object *> objects;
+  /// \brief Root of the tree each listed Object was in when the list was sorted
+  ///        nullptr for Objects added since, which have to be checked by walking up the tree
+  ///        Only attaching and removing change an Object's root, and both unsort the list
+  std::vector<Object *> roots;
+  /// \brief Member of Object holding its index in this list
+  unsigned Object::*index;
+  /// \brief Number of nullptr slots in objects
+  unsigned holes = 0;
+  /// \brief Number of RunPhase calls currently running
+  ///        Compaction is deferred until this is 0 so indices don't shift under a running RunPhase
+  unsigned iterating = 0;
+  /// \brief True while objects is in tree pre-order and roots is up to date
+  ///        Cleared whenever an Object is attached or removed, since its listed descendants move with it
+  bool sorted = true;
+  /// \brief Guards changes to objects so Objects can be attached by parallel update jobs
+  std::mutex mutex;
+
+  /// \brief Constructor
+  /// \param i Member of Object holding its index in this list
+  explicit PhaseList(unsigned Object::*i)
+      : index(i)
+  {
+  }
+
+  /// \brief Adds an Object to the end of the list
+  ///        Does nothing if it's already listed
+  /// \param o Object to add
+  void Add(Object *o)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (o->*index != PHASE_LIST_NONE)
+      return;
+    o->*index = unsigned(objects.size());
+    objects.push_back(o);
+    roots.push_back(nullptr);
+    sorted = false;
+  }
+
+  /// \brief Marks the list as out of order
+  ///        Called when an Object is attached or removed, since listed descendants it brings along move with it
+  void Unsort()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    sorted = false;
+  }
+
+  /// \brief Puts objects back in tree pre-order and removes every nullptr slot
+  ///        Walks the tree of each listed Object that an earlier walk didn't reach
+  ///        The caller must hold mutex
+  void Sort()
+  {
+    /// \brief Object whose children are being walked
+    class SortFrame
+    {
+    public:
+      /// \brief Object whose children are being walked
+      Object *parent;
+      /// \brief Index of the next child to walk
+      unsigned index;
+    };
+    std::vector<Object *> ordered;
+    ordered.reserve(objects.size() - holes);
+    std::vector<Object *> orderedRoots;
+    orderedRoots.reserve(objects.size() - holes);
+    std::vector<SortFrame> stack;
+    for (unsigned i = 0; i < objects.size(); ++i)
+    {
+      if (!objects[i])
+        continue;
+      // Objects are taken out of objects as they're reached, so this one's tree hasn't been walked yet
+      Object *root = objects[i]->Root();
+      stack.push_back(SortFrame{root, 0});
+      while (!stack.empty())
+      {
+        SortFrame &top = stack.back();
+        if (top.index >= top.parent->Children().size())
+        {
+          stack.pop_back();
+          continue;
+        }
+        Object *child = top.parent->Children()[top.index++];
+        unsigned at = child->*index;
+        if (at != PHASE_LIST_NONE && objects[at] == child)
+        {
+          objects[at] = nullptr;
+          child->*index = unsigned(ordered.size());
+          ordered.push_back(child);
+          orderedRoots.push_back(root);
+        }
+        stack.push_back(SortFrame{child, 0});
+      }
+      // Only reached if it isn't in its parent's children, which attached Objects always are
+      if (objects[i])
+      {
+        objects[i]->*index = unsigned(ordered.size());
+        ordered.push_back(objects[i]);
+        orderedRoots.push_back(root);
+        objects[i] = nullptr;
+      }
+    }
+    objects.swap(ordered);
+    roots.swap(orderedRoots);
+    holes = 0;
+    sorted = true;
+  }
+
+  /// \brief Removes an Object from the list
+  ///        Does nothing if it isn't listed
+  /// \param o Object to remove
+  void Remove(Object *o)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (o->*index == PHASE_LIST_NONE)
+      return;
+    objects[o->*index] = nullptr;
+    o->*index = PHASE_LIST_NONE;
+    ++holes;
+    if (iterating == 0 && holes * 2 > objects.size())
+      Compact();
+  }
+
+  /// \brief Removes every nullptr slot while keeping the remaining Objects in order
+  ///        The caller must hold mutex
+  void Compact()
+  {
+    unsigned j = 0;
+    for (unsigned i = 0; i < objects.size(); ++i)
+    {
+      if (objects[i])
+      {
+        objects[j] = objects[i];
+        roots[j] = roots[i];
+        objects[j]->*index = j;
+        ++j;
+      }
+    }
+    objects.resize(j);
+    roots.resize(j);
+    holes = 0;
+  }
+};
+
+/// \brief Size granularity of slab pools
+///        Also the alignment of every pooled Object
+static const std::size_t POOL_GRANULARITY = 16;
+/// \brief Number of slab pools
+static const std::size_t POOL_COUNT = Object::MAX_POOLED_SIZE / POOL_GRANULARITY;
+/// \brief Preferred number of bytes in a slab
+static const std::size_t SLAB_BYTES = 1 << 16;
+/// \brief Fewest slots a slab holds
+static const std::size_t SLAB_MIN_SLOTS = 16;
+
+/// \brief Number of Objects allocated from slab pools
+static std::atomic<unsigned> _pooledCount(0);
+/// \brief Number of bytes in all slabs
+static std::atomic<std::size_t> _pooledBytes(0);
+
+/// \brief Slab allocator for Objects of a single size
+///        Memory is reserved a slab at a time and never returned to the heap
+///        Freed slots are kept in a list threaded through the slots themselves
+class Pool
+{
+public:
+  /// \brief Unused slot
+  class Slot
+  {
+  public:
+    /// \brief Next unused slot
+    Slot *next;
+  };
+
+  /// \brief Size of each slot
+  std::size_t slotSize = 0;
+  /// \brief First unused slot
+  Slot *free = nullptr;
+  /// \brief Guards free
+  std::mutex mutex;
+
+  /// \brief Takes an unused slot
+  ///        Reserves a new slab if there are none
+  /// \return Memory for an Object
+  void *Allocate()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!free)
+      Grow();
+    Slot *slot = free;
+    free = slot->next;
+    return slot;
+  }
+
+  /// \brief Returns a slot to the unused list
+  /// \param p Slot to return
+  void Free(void *p)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    Slot *slot = static_cast<Slot *>(p);
+    slot->next = free;
+    free = slot;
+  }
+
+  /// \brief Reserves a new slab and adds its slots to the unused list
+  ///        Slots are listed in address order so Objects created together sit next to each other
+  void Grow()
+  {
+    std::size_t slots = std::max(SLAB_BYTES / slotSize, SLAB_MIN_SLOTS);
+    char *slab = static_cast<char *>(::operator new(slots * slotSize));
+    _pooledBytes += slots * slotSize;
+    for (std::size_t i = slots; i-- > 0;)
+    {
+      Slot *slot = reinterpret_cast<Slot *>(slab + i * slotSize);
+      slot->next = free;
+      free = slot;
+    }
+  }
+};
+
+/// \brief Gets the pool for Objects of the given size
+///        Pools are never destroyed so Objects deleted during static destruction can still be freed
+/// \param size Size of the Object
+/// \return Pool for the size
+static Pool &GetPool(std::size_t size)
+{
+  static Pool *pools = []() {
+    Pool *p = new Pool[POOL_COUNT];
+    for (std::size_t i = 0; i < POOL_COUNT; ++i)
+      p[i].slotSize = (i + 1) * POOL_GRANULARITY;
+    return p;
+  }();
+  return pools[(size - 1) / POOL_GRANULARITY];
+}
+
+void *Object::operator new(std::size_t size)
+{
+  if (size == 0 || size > MAX_POOLED_SIZE)
+    return ::operator new(size);
+  ++_pooledCount;
+  return GetPool(size).Allocate();
+}
+
+void Object::operator delete(void *p, std::size_t size)
+{
+  if (!p)
+    return;
+  if (size == 0 || size > MAX_POOLED_SIZE)
+  {
+    ::operator delete(p);
+    return;
+  }
+  --_pooledCount;
+  GetPool(size).Free(p);
+}
+
+unsigned Object::PooledCount()
+{
+  return _pooledCount;
+}
+
+std::size_t Object::PooledBytes()
+{
+  return _pooledBytes;
+}
+
+ChildList::ChildList()
+    : _heap(nullptr), _size(0), _capacity(INLINE_CAPACITY)
+{
+}
+
+ChildList::~ChildList()
+{
+  if (_capacity > INLINE_CAPACITY)
+    delete[] _heap;
+}
+
+void ChildList::push_back(Object *child)
+{
+  if (_size == _capacity)
+    reserve(_capacity * 2);
+  Data()[_size++] = child;
+}
+
+void ChildList::reserve(unsigned capacity)
+{
+  if (capacity <= _capacity)
+    return;
+  Object **heap = new Object *[capacity];
+  std::copy(begin(), end(), heap);
+  if (_capacity > INLINE_CAPACITY)
+    delete[] _heap;
+  _heap = heap;
+  _capacity = capacity;
+}
+
+ChildList::iterator ChildList::erase(iterator it)
+{
+  std::copy(it + 1, end(), it);
+  --_size;
+  return it;
+}
+
+void ChildList::resize(unsigned size)
+{
+  while (_size < size)
+    push_back(nullptr);
+  _size = size;
+}
+
+void ChildList::clear()
+{
+  _size = 0;
+}
 
 Object::Object(Object *parent, std::string name)
-    : _name(name), _parent(parent),
-      _children(), _valid(false), _active(true), _started(false),
+    : _nameId(InternName(name)), _handleSlot(AllocateHandleSlot(this)), _parent(parent), _children(),
+      _earlyIndex(PHASE_LIST_NONE), _lateIndex(PHASE_LIST_NONE),
+      _valid(false), _active(true), _activeInTree(false), _started(false), _attached(false), _parallel(false),
+      _ownsTransform(false), _updatesOwnChildren(false), _draws(false), _sleeping(false), _autoSleep(false),
+      _phases(PHASES::ALL), _hasEndedChildren(false),
+      _updateInterval(0), _updateOffset(0), _rateInterval(1), _rateOffset(0), _idleFrames(0),
       _transform(nullptr), _collider(nullptr), _rigidbody(nullptr)
 {
   ++_count;
   if ((dynamic_cast<Engine::Engine *>(this) && dynamic_cast<Engine::Engine *>(this)->Debug()) ||
       (Engine::Engine::Get() && Engine::Engine::Get()->Debug()))
-    Log::Debug("Creating %s:  %p  %d", _name.c_str(), this, _count);
+    Log::Debug("Creating %s:  %p  %d", Name().c_str(), this, int(_count));
+
+  _valid = true;
+  RefreshActive();
+  RefreshUpdateRate();
+}
+
+Object::Object(const Object &other, Object *parent)
+    : _nameId(other._nameId), _handleSlot(AllocateHandleSlot(this)), _parent(parent), _children(),
+      _earlyIndex(PHASE_LIST_NONE), _lateIndex(PHASE_LIST_NONE),
+      _valid(false), _active(other._active), _activeInTree(false), _started(false), _attached(false), _parallel(other._parallel),
+      _ownsTransform(false), _updatesOwnChildren(other._updatesOwnChildren), _draws(other._draws), _sleeping(other._sleeping), _autoSleep(other._autoSleep),
+      _phases(other._phases), _hasEndedChildren(false),
+      _updateInterval(0), _updateOffset(0), _rateInterval(1), _rateOffset(0), _idleFrames(0),
+      _transform(nullptr), _collider(nullptr), _rigidbody(nullptr)
+{
+  ++_count;
+  if (Engine::Engine::Get() && Engine::Engine::Get()->Debug())
+    Log::Debug("Cloning %s:  %p  %d", Name().c_str(), this, int(_count));
 
+  if (other._ownsTransform)
+    *CreateTransform() = *other._transform;
   _valid = true;
+  RefreshActive();
+  // Copies are given offsets in turn like any other Object setting the same interval
+  UpdateInterval(other._updateInterval);
+  RefreshUpdateRate();
 }
 
 Object::~Object()
@@ -35,7 +569,7 @@ Object::~Object()
   if ((dynamic_cast<Engine::Engine *>(this) && dynamic_cast<Engine::Engine *>(this)->Debug()) ||
       (Engine::Engine::Get() && Engine::Engine::Get()->Debug()))
   {
-    Log::Debug("Destroying %s:  %p  %d", _name.c_str(), this, _count);
+    Log::Debug("Destroying %s:  %p  %d", Name().c_str(), this, int(_count));
     if (_count == 0)
       Log::Debug("All clean :D");
   }
@@ -43,6 +577,33 @@ Object::~Object()
   for (Object *child : _children)
     delete child;
   _children.clear();
+  if (_hasEndedChildren)
+  {
+    std::lock_guard<std::mutex> lock(_withEndedChildrenMutex);
+    _withEndedChildren.erase(std::find(_withEndedChildren.begin(), _withEndedChildren.end(), this));
+  }
+  _attached = false;
+  UpdatePhaseLists();
+  if (_ownsTransform)
+    delete _transform;
+  FreeHandleSlot(_handleSlot);
+}
+
+unsigned Object::HandleSlot() const
+{
+  return _handleSlot;
+}
+
+unsigned Object::HandleGeneration() const
+{
+  if (_handleSlot == HANDLE_NONE)
+    return 0;
+  return GetHandleSlot(_handleSlot).generation.load(std::memory_order_acquire);
+}
+
+Handle<Object> Object::GetHandle()
+{
+  return Handle<Object>(this);
 }
 
 const Object *Object::Parent() const
@@ -57,9 +618,17 @@ Object *Object::Parent()
 
 void Object::SetParent(Object *parent)
 {
-  if (_parent)
+  if (_parent && _attached)
     _parent->RemoveChild(this);
+  // Listed descendants change trees with this Object even if it isn't attached
+  if (_parent != parent)
+  {
+    GetPhaseList(PHASES::EARLY_UPDATE).Unsort();
+    GetPhaseList(PHASES::LATE_UPDATE).Unsort();
+  }
   _parent = parent;
+  RefreshActive();
+  RefreshUpdateRate();
 }
 
 Object *Object::Root()
@@ -88,6 +657,16 @@ const Transform::Transform *Object::GetTransform() const
   return _transform;
 }
 
+Transform::Transform *Object::CreateTransform()
+{
+  if (!_transform)
+  {
+    new Transform::Transform(this);
+    _ownsTransform = true;
+  }
+  return _transform;
+}
+
 Physics::Collider *Object::GetCollider()
 {
   return _collider;
@@ -109,59 +688,555 @@ const Physics::Rigidbody *Object::GetRigidbody() const
 }
 
 void Object::operator()()
+{
+  UpdateTree(nullptr);
+}
+
+void Object::UpdateTree(TraversalCache *cache)
 {
   if (!Active())
+  {
+    // Objects whose constructors cleared _valid never call End, so they're reaped from here
+    if (!_valid && _attached)
+      _parent->QueueEndedChild();
     return;
+  }
   if (!_started)
   {
     OnStart();
     OnActivate();
     _started = true;
   }
-  OnUpdate();
-  for (unsigned i = 0; i < _children.size(); ++i)
+  if ((_phases & PHASES::UPDATE) && UpdateDue() && !_sleeping)
+    OnUpdate();
+  if (_autoSleep && !_sleeping && ++_idleFrames >= _sleepDelay)
+    Sleep();
+  if (this == _passObject)
   {
-    Object *child = _children[i];
-    (*child)();
-    if (!child->Valid())
+    // The pass this Object is in updates its children next
+    _passObject = nullptr;
+    _passDescend = true;
+    return;
+  }
+  ++_updateDepth;
+  if (_parallel && _children.size() > 1)
+    UpdateChildrenInParallel();
+  else
+    UpdateDescendants(cache);
+  if (--_updateDepth == 0 && !_parent)
+    DestroyEnded();
+}
+
+void Object::UpdateDescendants(TraversalCache *cache)
+{
+  if (_children.empty())
+    return;
+  std::size_t base = _passStack.size();
+  if (!cache)
+  {
+    _passStack.push_back(PassFrame{this, 0});
+    WalkPass(base);
+    return;
+  }
+  if (cache->_root != this || cache->_version != _treeVersion.load(std::memory_order_relaxed))
+    BuildTraversal(*cache);
+  unsigned version = cache->_version;
+  std::vector<TraversalCache::Entry> &entries = cache->_entries;
+  unsigned i = 0;
+  while (i < entries.size())
+  {
+    bool descend = entries[i].asleep || UpdateInPass(entries[i].object);
+    if (_treeVersion.load(std::memory_order_relaxed) != version)
+    {
+      // The list no longer matches the tree, so the rest of the pass walks the tree from where it got to
+      // Each ancestor continues from the child after the one being updated, like a recursive update would
+      std::size_t top = _passStack.size();
+      for (unsigned e = i; e != TraversalCache::TRAVERSAL_ROOT; e = entries[e].parent)
+      {
+        unsigned parent = entries[e].parent;
+        _passStack.push_back(PassFrame{parent == TraversalCache::TRAVERSAL_ROOT ? this : entries[parent].object,
+                                       entries[e].childIndex + 1});
+      }
+      std::reverse(_passStack.begin() + top, _passStack.end());
+      if (descend)
+        _passStack.push_back(PassFrame{entries[i].object, 0});
+      WalkPass(base);
+      return;
+    }
+    i = descend ? i + 1 : entries[i].end;
+  }
+}
+
+void Object::BuildTraversal(TraversalCache &cache)
+{
+  /// \brief Object whose children are being listed
+  class BuildFrame
+  {
+  public:
+    /// \brief Object whose children are being listed
+    Object *parent;
+    /// \brief Index of the parent's entry
+    unsigned entry;
+    /// \brief Index of the next child to list
+    unsigned index;
+  };
+  cache._root = this;
+  cache._version = _treeVersion.load(std::memory_order_relaxed);
+  cache._entries.clear();
+  std::vector<BuildFrame> stack;
+  stack.push_back(BuildFrame{this, TraversalCache::TRAVERSAL_ROOT, 0});
+  while (!stack.empty())
+  {
+    BuildFrame &top = stack.back();
+    if (top.index >= top.parent->_children.size())
     {
-      RemoveChild(child);
-      delete child;
-      --i;
+      if (top.entry != TraversalCache::TRAVERSAL_ROOT)
+        cache._entries[top.entry].end = unsigned(cache._entries.size());
+      stack.pop_back();
+      continue;
     }
+    unsigned childIndex = top.index++;
+    Object *child = top.parent->_children[childIndex];
+    if (!child->Active())
+    {
+      if (!child->_valid)
+        top.parent->QueueEndedChild();
+      continue;
+    }
+    unsigned entry = unsigned(cache._entries.size());
+    bool asleep = child->SkippedWhileAsleep();
+    cache._entries.push_back(TraversalCache::Entry{child, top.entry, childIndex, entry + 1, asleep});
+    if (!child->_children.empty() && (asleep || !child->UpdatesOwnChildren()))
+      stack.push_back(BuildFrame{child, entry, 0});
+  }
+}
+
+bool Object::SkippedWhileAsleep() const
+{
+  return _sleeping && !_draws;
+}
+
+bool Object::UpdateInPass(Object *o)
+{
+  ASPEN_PROFILE_ZONE(o->Name());
+  if (o->UpdatesOwnChildren())
+  {
+    (*o)();
+    return false;
+  }
+  _passObject = o;
+  _passDescend = false;
+  (*o)();
+  bool descend = _passDescend;
+  _passObject = nullptr;
+  _passDescend = false;
+  return descend && !o->_children.empty();
+}
+
+void Object::WalkPass(std::size_t base)
+{
+  while (_passStack.size() > base)
+  {
+    PassFrame &top = _passStack.back();
+    if (top.index >= top.parent->_children.size())
+    {
+      _passStack.pop_back();
+      continue;
+    }
+    Object *child = top.parent->_children[top.index++];
+    if (!child->Active())
+    {
+      if (!child->_valid)
+        top.parent->QueueEndedChild();
+      continue;
+    }
+    if (child->SkippedWhileAsleep() ? !child->_children.empty() : UpdateInPass(child))
+      _passStack.push_back(PassFrame{child, 0});
+  }
+}
+
+void Object::UpdateChildrenInParallel()
+{
+  // Jobs read world values anywhere in the tree, so every cache they could fill in lazily is filled in now
+  Transform::Transform::UpdateTreeCache(this);
+  Object *treeRoot = _currentJob ? _currentJob->treeRoot : Root();
+  std::vector<ParallelJob> jobs(_children.size());
+  {
+    Jobs::Group group;
+    _parallelUpdates.fetch_add(1, std::memory_order_acq_rel);
+    for (unsigned i = 0; i < jobs.size(); ++i)
+    {
+      jobs[i].root = _children[i];
+      jobs[i].treeRoot = treeRoot;
+      ParallelJob *job = &jobs[i];
+      group.Run([job]() {
+        ParallelJob *outer = _currentJob;
+        _currentJob = job;
+        {
+          ASPEN_PROFILE_ZONE(job->root->Name());
+          (*job->root)();
+        }
+        _currentJob = outer;
+      });
+    }
+    group.Wait();
+    _parallelUpdates.fetch_sub(1, std::memory_order_acq_rel);
+  }
+  // Runs now if this is the outermost parallel update, otherwise passes them on to the job this is part of
+  for (ParallelJob &job : jobs)
+    for (std::function<void()> &fn : job.deferred)
+      Defer(std::move(fn));
+}
+
+bool Object::OwnedByCurrentJob() const
+{
+  if (!_currentJob)
+    return true;
+  for (const Object *o = this;; o = o->_parent)
+  {
+    if (o == _currentJob->root)
+      return true;
+    if (!o->_parent)
+      return o != _currentJob->treeRoot;
+    if (!o->_attached)
+      return true;
+  }
+}
+
+PhaseList &Object::GetPhaseList(unsigned phase)
+{
+  static PhaseList early(&Object::_earlyIndex);
+  static PhaseList late(&Object::_lateIndex);
+  return phase == PHASES::EARLY_UPDATE ? early : late;
+}
+
+void Object::UpdatePhaseLists()
+{
+  if (_attached && (_phases & PHASES::EARLY_UPDATE))
+    GetPhaseList(PHASES::EARLY_UPDATE).Add(this);
+  else if (_earlyIndex != PHASE_LIST_NONE)
+    GetPhaseList(PHASES::EARLY_UPDATE).Remove(this);
+  if (_attached && (_phases & PHASES::LATE_UPDATE))
+    GetPhaseList(PHASES::LATE_UPDATE).Add(this);
+  else if (_lateIndex != PHASE_LIST_NONE)
+    GetPhaseList(PHASES::LATE_UPDATE).Remove(this);
+}
+
+unsigned Object::Phases() const
+{
+  return _phases;
+}
+
+void Object::Phases(unsigned phases)
+{
+  _phases = (unsigned char)(phases & PHASES::ALL);
+  UpdatePhaseLists();
+}
+
+void Object::RunPhase(unsigned phase)
+{
+  PhaseList &list = GetPhaseList(phase);
+  if (!list.sorted && list.iterating == 0)
+  {
+    std::lock_guard<std::mutex> lock(list.mutex);
+    list.Sort();
+  }
+  // Listed Objects are compared against their cached roots, so only Objects under something else have to walk up the tree
+  Object *root = Root();
+  bool isRoot = root == this;
+  ++list.iterating;
+  for (unsigned i = 0; i < list.objects.size(); ++i)
+  {
+    Object *o = list.objects[i];
+    if (!o || o == this || !o->Active() || o->_sleeping || !o->UpdateDue())
+      continue;
+    Object *listedRoot = list.roots[i];
+    if (listedRoot ? listedRoot != root || (!isRoot && !o->HasAncestor(this)) : !o->HasAncestor(this))
+      continue;
+    if (phase == PHASES::EARLY_UPDATE)
+      o->OnEarlyUpdate();
+    else
+      o->OnLateUpdate();
+  }
+  if (--list.iterating == 0 && list.holes > 0)
+  {
+    std::lock_guard<std::mutex> lock(list.mutex);
+    list.Compact();
+  }
+}
+
+unsigned Object::UpdateInterval() const
+{
+  return _rateInterval;
+}
+
+void Object::UpdateInterval(unsigned interval)
+{
+  if (interval > MAX_UPDATE_INTERVAL)
+  {
+    Log::Warning("%s's update interval of %u is above the maximum of %u", Name().c_str(), interval, MAX_UPDATE_INTERVAL);
+    interval = MAX_UPDATE_INTERVAL;
   }
+  if (interval == _updateInterval)
+    return;
+  _updateInterval = (unsigned char)interval;
+  _updateOffset = interval > 1 ? (unsigned char)(_nextUpdateOffset[interval]++ % interval) : 0;
+  RefreshUpdateRate();
+}
+
+unsigned Object::UpdateOffset() const
+{
+  return _rateOffset;
+}
+
+bool Object::UpdateDue() const
+{
+  return UpdateDue(_frame);
+}
+
+bool Object::UpdateDue(unsigned long long count) const
+{
+  return _rateInterval <= 1 || (count + _rateOffset) % _rateInterval == 0;
+}
+
+double Object::UpdateDeltaTime() const
+{
+  if (_frame == 0)
+    return _rateInterval / 60.0;
+  unsigned long long frames = _frame < _rateInterval ? _frame : _rateInterval;
+  return _frameClock[_frame % FRAME_CLOCK_SIZE] - _frameClock[(_frame - frames) % FRAME_CLOCK_SIZE];
+}
+
+void Object::AdvanceFrame(double deltaTime)
+{
+  double clock = _frameClock[_frame % FRAME_CLOCK_SIZE] + deltaTime;
+  ++_frame;
+  _frameClock[_frame % FRAME_CLOCK_SIZE] = clock;
+}
+
+unsigned long long Object::Frame()
+{
+  return _frame;
+}
+
+void Object::RefreshUpdateRate()
+{
+  unsigned char interval = 1;
+  unsigned char offset = 0;
+  if (_updateInterval > 0)
+  {
+    interval = _updateInterval;
+    offset = _updateOffset;
+  }
+  else if (_parent)
+  {
+    interval = _parent->_rateInterval;
+    offset = _parent->_rateOffset;
+  }
+  if (interval == _rateInterval && offset == _rateOffset)
+    return;
+  _rateInterval = interval;
+  _rateOffset = offset;
+  if (_attached)
+    TreeChanged();
+  for (Object *c : _children)
+    c->RefreshUpdateRate();
+}
+
+bool Object::Sleeping() const
+{
+  return _sleeping;
+}
+
+void Object::Sleep()
+{
+  if (_sleeping)
+    return;
+  // Only clean transform caches wake their owners when they're invalidated, so make sure this one is
+  Transform::Transform::UpdateCache(this);
+  _sleeping = true;
+  _idleFrames = 0;
+  if (_attached)
+    TreeChanged();
+}
+
+void Object::Wake()
+{
+  _idleFrames = 0;
+  if (!_sleeping)
+    return;
+  _sleeping = false;
+  if (_attached)
+    TreeChanged();
+}
+
+bool Object::AutoSleep() const
+{
+  return _autoSleep;
+}
+
+void Object::AutoSleep(bool autoSleep)
+{
+  _autoSleep = autoSleep;
+  _idleFrames = 0;
+}
+
+unsigned Object::SleepDelay()
+{
+  return _sleepDelay;
+}
+
+void Object::SleepDelay(unsigned frames)
+{
+  if (frames == 0 || frames > MAX_SLEEP_DELAY)
+  {
+    Log::Warning("A sleep delay of %u frames is outside of 1 to %u", frames, MAX_SLEEP_DELAY);
+    frames = std::min(std::max(frames, 1u), MAX_SLEEP_DELAY);
+  }
+  _sleepDelay = frames;
+}
+
+bool Object::UpdatesOwnChildren() const
+{
+  return _updatesOwnChildren || (_parallel && _children.size() > 1);
+}
+
+void Object::UpdatesOwnChildren(bool updatesOwnChildren)
+{
+  if (updatesOwnChildren == _updatesOwnChildren)
+    return;
+  _updatesOwnChildren = updatesOwnChildren;
+  if (_attached)
+    TreeChanged();
+}
+
+bool Object::Parallel() const
+{
+  return _parallel;
+}
+
+void Object::Parallel(bool parallel)
+{
+  if (parallel == _parallel)
+    return;
+  _parallel = parallel;
+  if (_attached)
+    TreeChanged();
+}
+
+void Object::Defer(std::function<void()> fn)
+{
+  if (_currentJob)
+    _currentJob->deferred.push_back(std::move(fn));
+  else
+    fn();
+}
+
+bool Object::InParallelUpdate()
+{
+  return _currentJob != nullptr;
+}
+
+unsigned Object::TreeVersion()
+{
+  return _treeVersion.load(std::memory_order_relaxed);
+}
+
+bool Object::ParallelUpdateRunning()
+{
+  return _parallelUpdates.load(std::memory_order_acquire) != 0;
 }
 
 void Object::AddChild(Object *child)
 {
   if (!child || this == child)
     return;
-  if (std::find(_children.begin(), _children.end(), child) == _children.end())
+  if (!OwnedByCurrentJob())
+  {
+    Defer([this, child]() { AddChild(child); });
+    return;
+  }
+  // Attached children are always in their parent's list, so there's no need to search it
+  if (!child->_attached || child->_parent != this)
   {
     child->SetParent(this);
     _children.push_back(child);
+    child->_attached = true;
+    child->UpdatePhaseLists();
+    // Listed descendants of child have moved with it
+    GetPhaseList(PHASES::EARLY_UPDATE).Unsort();
+    GetPhaseList(PHASES::LATE_UPDATE).Unsort();
+    TreeChanged();
   }
-  if (!_transform && dynamic_cast<Transform::Transform *>(child))
-    _transform = dynamic_cast<Transform::Transform *>(child);
-  else if (!_collider && dynamic_cast<Physics::Collider *>(child))
+  // Children invalidated by their constructors never call End, so they're queued to be deleted here
+  if (!child->_valid)
+    QueueEndedChild();
+  Transform::Transform::InvalidateTree(child);
+  if (!_collider && dynamic_cast<Physics::Collider *>(child))
     _collider = dynamic_cast<Physics::Collider *>(child);
   else if (!_rigidbody && dynamic_cast<Physics::Rigidbody *>(child))
     _rigidbody = dynamic_cast<Physics::Rigidbody *>(child);
 }
 
+Object *Object::Clone(Object *parent) const
+{
+  if (typeid(*this) != typeid(Object))
+  {
+    Log::Error("%s can't be cloned since its type doesn't override Clone", Name().c_str());
+    return nullptr;
+  }
+  return new Object(*this, parent);
+}
+
+Object *Object::CloneTree(Object *parent) const
+{
+  Object *root = Clone(parent);
+  if (!root)
+    return nullptr;
+  if (parent)
+    parent->AddChild(root);
+  // Pairs of an original and the copy of its parent
+  // Children are pushed in reverse so each parent's copies are added in the same order as the originals
+  std::vector<std::pair<const Object *, Object *>> stack;
+  for (unsigned i = _children.size(); i-- > 0;)
+    if (_children[i]->_valid)
+      stack.emplace_back(_children[i], root);
+  while (!stack.empty())
+  {
+    const Object *original = stack.back().first;
+    Object *copyParent = stack.back().second;
+    stack.pop_back();
+    Object *copy = original->Clone(copyParent);
+    if (!copy)
+      continue;
+    copyParent->AddChild(copy);
+    for (unsigned i = original->_children.size(); i-- > 0;)
+      if (original->_children[i]->_valid)
+        stack.emplace_back(original->_children[i], copy);
+  }
+  return root;
+}
+
 void Object::RemoveChild(Object *child)
 {
   if (!child || this == child)
     return;
-  std::vector<Object *>::iterator it = std::find(_children.begin(), _children.end(), child);
+  ChildList::iterator it = std::find(_children.begin(), _children.end(), child);
   if (it != _children.end())
   {
+    Transform::Transform::InvalidateTree(child);
+    // Listed descendants of child are now in its tree
+    GetPhaseList(PHASES::EARLY_UPDATE).Unsort();
+    GetPhaseList(PHASES::LATE_UPDATE).Unsort();
     (*it)->_parent = nullptr;
+    (*it)->_attached = false;
+    (*it)->UpdatePhaseLists();
+    (*it)->RefreshActive();
+    (*it)->RefreshUpdateRate();
     _children.erase(it);
+    TreeChanged();
   }
-  if (_transform == child)
-    _transform = FindChildOfType<Transform::Transform>();
-  else if (_collider == child)
+  if (_collider == child)
     _collider = FindChildOfType<Physics::Collider>();
   else if (_rigidbody == child)
     _rigidbody = FindChildOfType<Physics::Rigidbody>();
@@ -171,14 +1246,21 @@ void Object::RemoveChild(unsigned index)
 {
   if (index < _children.size())
   {
+    Transform::Transform::InvalidateTree(_children[index]);
+    // Listed descendants of the child are now in its tree
+    GetPhaseList(PHASES::EARLY_UPDATE).Unsort();
+    GetPhaseList(PHASES::LATE_UPDATE).Unsort();
     _children[index]->_parent = nullptr;
-    if (_transform == _children[index])
-      _transform = FindChildOfType<Transform::Transform>();
-    else if (_collider == _children[index])
+    _children[index]->_attached = false;
+    _children[index]->UpdatePhaseLists();
+    _children[index]->RefreshActive();
+    _children[index]->RefreshUpdateRate();
+    if (_collider == _children[index])
       _collider = FindChildOfType<Physics::Collider>();
     else if (_rigidbody == _children[index])
       _rigidbody = FindChildOfType<Physics::Rigidbody>();
     _children.erase(_children.begin() + index);
+    TreeChanged();
   }
 }
 
@@ -191,7 +1273,7 @@ Object *Object::operator[](unsigned index)
 
 int Object::operator[](Object *child)
 {
-  std::vector<Object *>::iterator it = std::find(_children.begin(), _children.end(), child);
+  ChildList::iterator it = std::find(_children.begin(), _children.end(), child);
   if (it == _children.end())
     return -1;
   return _children.end() - _children.begin();
@@ -216,18 +1298,28 @@ int Object::ParentCount()
   return i;
 }
 
-const bool &Object::Valid() const
+bool Object::Valid() const
 {
   return _valid;
 }
 
 bool Object::Active() const
 {
-  if (!_valid || !_active)
-    return false;
-  if (_parent)
-    return _parent->Active();
-  return true;
+  // _valid is checked as well since derived constructors may clear it without refreshing
+  return _valid && _activeInTree;
+}
+
+void Object::RefreshActive()
+{
+  bool active = _valid && _active && (!_parent || _parent->Active());
+  if (active == _activeInTree)
+    return;
+  _activeInTree = active;
+  // Only attached Objects are in anyone's TraversalCache, so constructing an Object doesn't rebuild them
+  if (_attached)
+    TreeChanged();
+  for (Object *c : _children)
+    c->RefreshActive();
 }
 
 void Object::SetActive(bool active)
@@ -243,6 +1335,7 @@ void Object::Activate()
   if (!_active)
   {
     _active = true;
+    RefreshActive();
     TriggerOnActivate();
   }
 }
@@ -253,6 +1346,7 @@ void Object::Deactivate()
   {
     TriggerOnDeactivate();
     _active = false;
+    RefreshActive();
   }
 }
 
@@ -295,13 +1389,92 @@ Object::operator bool() const
 
 void Object::End()
 {
-  if (!Valid())
+  if (!Valid() || DeferEnd())
     return;
   OnDeactivate();
   OnEnd();
   for (Object *c : _children)
     c->End();
   _valid = false;
+  RefreshActive();
+  if (_parent)
+    _parent->QueueEndedChild();
+}
+
+bool Object::DeferEnd()
+{
+  if (!_currentJob || !_valid)
+    return false;
+  // A handle stops resolving if the Object is ended or deleted before this runs
+  Handle<Object> handle(this);
+  Defer([handle]() {
+    Object *o = handle.Get();
+    if (o)
+      o->End();
+  });
+  return true;
+}
+
+void Object::QueueEndedChild()
+{
+  std::lock_guard<std::mutex> lock(_withEndedChildrenMutex);
+  if (_hasEndedChildren)
+    return;
+  _hasEndedChildren = true;
+  _withEndedChildren.push_back(this);
+}
+
+void Object::CompactChildren(std::vector<Object *> &ended)
+{
+  _hasEndedChildren = false;
+  unsigned j = 0;
+  for (unsigned i = 0; i < _children.size(); ++i)
+  {
+    Object *child = _children[i];
+    if (child->Valid())
+    {
+      _children[j++] = child;
+      continue;
+    }
+    if (child == _collider)
+      _collider = nullptr;
+    else if (child == _rigidbody)
+      _rigidbody = nullptr;
+    child->_parent = nullptr;
+    child->_attached = false;
+    child->UpdatePhaseLists();
+    ended.push_back(child);
+  }
+  if (j == _children.size())
+    return;
+  _children.resize(j);
+  TreeChanged();
+  if (!_collider)
+    _collider = FindChildOfType<Physics::Collider>();
+  if (!_rigidbody)
+    _rigidbody = FindChildOfType<Physics::Rigidbody>();
+}
+
+void Object::DestroyEnded()
+{
+  std::vector<Object *> parents;
+  std::vector<Object *> ended;
+  while (true)
+  {
+    {
+      std::lock_guard<std::mutex> lock(_withEndedChildrenMutex);
+      if (_withEndedChildren.empty())
+        return;
+      parents.swap(_withEndedChildren);
+    }
+    // Every parent is compacted before anything is deleted so no queued parent is deleted first
+    for (Object *parent : parents)
+      parent->CompactChildren(ended);
+    for (Object *o : ended)
+      delete o;
+    parents.clear();
+    ended.clear();
+  }
 }
 
 void Object::PrintTree(Log::Log &log) const
@@ -311,7 +1484,7 @@ void Object::PrintTree(Log::Log &log) const
   static bool madeSpace = false;
   if (indentation.length() == 0)
   {
-    log("%s (%p) (%s)", _name.c_str(), this, Valid() ? "Valid" : "Ended");
+    log("%s (%p) (%s)", Name().c_str(), this, Valid() ? "Valid" : "Ended");
     if (_children.size() > 0)
       indentation = "  ";
   }
@@ -319,13 +1492,13 @@ void Object::PrintTree(Log::Log &log) const
   {
     if (this == _parent->GetLastChild())
     {
-      log("%s\\... %s (%p) (%s)", indentation.c_str(), _name.c_str(), this, Valid() ? "Valid" : "Ended");
+      log("%s\\... %s (%p) (%s)", indentation.c_str(), Name().c_str(), this, Valid() ? "Valid" : "Ended");
       if (_children.size() > 0)
         indentation = indentation + "       ";
     }
     else
     {
-      log("%s+--- %s (%p) (%s)", indentation.c_str(), _name.c_str(), this, Valid() ? "Valid" : "Ended");
+      log("%s+--- %s (%p) (%s)", indentation.c_str(), Name().c_str(), this, Valid() ? "Valid" : "Ended");
       if (_children.size() > 0)
         indentation = newindent + indentation;
     }
@@ -352,9 +1525,39 @@ void Object::PrintTree() const
   PrintTree(Log::Debug);
 }
 
-std::string Object::Name() const
+const std::string &Object::Name() const
+{
+  return NameOf(_nameId);
+}
+
+unsigned Object::NameId() const
 {
-  return _name;
+  return _nameId;
+}
+
+unsigned Object::InternName(const std::string &name)
+{
+  std::lock_guard<std::mutex> lock(_nameMutex);
+  std::unordered_map<std::string, unsigned>::iterator it = NameIndex().find(name);
+  if (it != NameIndex().end())
+    return it->second;
+  if (_nameCount == NAME_BLOCK_SIZE * NAME_BLOCK_COUNT)
+  {
+    Log::Error("The name table is full, so %s will be named %s", name.c_str(), _nameBlocks[0][0].c_str());
+    return 0;
+  }
+  unsigned id = _nameCount;
+  if (!_nameBlocks[id / NAME_BLOCK_SIZE])
+    _nameBlocks[id / NAME_BLOCK_SIZE] = new std::string[NAME_BLOCK_SIZE];
+  _nameBlocks[id / NAME_BLOCK_SIZE][id % NAME_BLOCK_SIZE] = name;
+  NameIndex().emplace(name, id);
+  ++_nameCount;
+  return id;
+}
+
+const std::string &Object::NameOf(unsigned id)
+{
+  return _nameBlocks[id / NAME_BLOCK_SIZE][id % NAME_BLOCK_SIZE];
 }
 
 unsigned Object::ChildrenCount() const
@@ -362,7 +1565,7 @@ unsigned Object::ChildrenCount() const
   return _children.size();
 }
 
-std::vector<Object *> &Object::Children()
+ChildList &Object::Children()
 {
   return _children;
 }
@@ -379,6 +1582,28 @@ bool Object::HasAncestor(const Object *other) const
 void Object::PopulateDebugger()
 {
   ImGui::Text("Children: %d", ChildrenCount());
+  if (_transform)
+    _transform->PopulateDebugger();
+  bool parallel = _parallel;
+  if (ImGui::Checkbox("Parallel Children", &parallel))
+    Parallel(parallel);
+  bool sleeping = _sleeping;
+  if (ImGui::Checkbox("Sleeping", &sleeping))
+  {
+    if (sleeping)
+      Sleep();
+    else
+      Wake();
+  }
+  bool autoSleep = _autoSleep;
+  if (ImGui::Checkbox("Auto Sleep", &autoSleep))
+    AutoSleep(autoSleep);
+  int interval = int(_updateInterval);
+  ImGui::InputInt("Update Interval", &interval, 1, 1);
+  if (interval >= 0 && interval != int(_updateInterval))
+    UpdateInterval(unsigned(interval));
+  if (_rateInterval > 1)
+    ImGui::Text("Update Offset: %u", unsigned(_rateOffset));
 }
 
 void Object::OnStart()
@@ -395,18 +1620,10 @@ void Object::OnUpdate()
 
 void Object::OnEarlyUpdate()
 {
-  if (!Active())
-    return;
-  for (unsigned i = 0; i < _children.size(); ++i)
-    _children[i]->OnEarlyUpdate();
 }
 
 void Object::OnLateUpdate()
 {
-  if (!Active())
-    return;
-  for (unsigned i = 0; i < _children.size(); ++i)
-    _children[i]->OnLateUpdate();
 }
 
 void Object::OnDeactivate()
@@ -440,5 +1657,49 @@ void Object::OnMouseClick()
 void Object::OnMouseRelease()
 {
 }
+
+/////////////////////////////////////////////////////////
+
+Prefab::Prefab(const Object *original)
+    : _template(original ? original->CloneTree() : nullptr)
+{
+  if (!_template)
+    Log::Error("Prefab couldn't capture its Object");
+}
+
+Prefab::~Prefab()
+{
+  delete _template;
+}
+
+bool Prefab::Valid() const
+{
+  return _template != nullptr;
+}
+
+Object *Prefab::Template()
+{
+  return _template;
+}
+
+Object *Prefab::Instantiate(Object *parent) const
+{
+  if (!_template)
+    return nullptr;
+  return _template->CloneTree(parent);
+}
+
+std::vector<Object *> Prefab::Instantiate(unsigned count, Object *parent) const
+{
+  std::vector<Object *> copies;
+  if (!_template)
+    return copies;
+  copies.reserve(count);
+  if (parent)
+    parent->Children().reserve(parent->ChildrenCount() + count);
+  for (unsigned i = 0; i < count; ++i)
+    copies.push_back(_template->CloneTree(parent));
+  return copies;
+}
 } // namespace Object
 } // namespace Aspen
@@ -5,12 +5,16 @@
 #include "Transform.hpp"
 #include "Collision.hpp"
 #include "Graphics.hpp"
-#include "Time.hpp"
 #include "Input.hpp"
 #include "Debug.hpp"
 #include "Log.hpp"
+#include "Profiler.hpp"
 #include "imgui.h"
 #include <limits>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #undef __PHYSICS_CPP
 
@@ -18,14 +22,188 @@ namespace Aspen
 {
 namespace Physics
 {
+const double DEFAULT_CELL_SIZE = 64.0;
+const int MAX_PROXY_CELLS = 64;
+
+/// \brief Values of up to SIZE Rigidbodies stored as one array per value
+///        Rigidbodies are views over a slot, so Physics::Integrate can read each value linearly
+class RigidbodyBlock
+{
+public:
+  /// \brief Number of slots in a block
+  static const unsigned SIZE = 256;
+  /// \brief Rigidbody using each slot
+  ///        nullptr for free slots
+  Rigidbody *owner[SIZE];
+  /// \brief Mass of each slot
+  double mass[SIZE];
+  /// \brief Horizontal velocity of each slot
+  double velocityX[SIZE];
+  /// \brief Vertical velocity of each slot
+  double velocityY[SIZE];
+  /// \brief Direction each slot's velocity was last given
+  ///        Only used while the velocity is 0, so setting its strength later keeps the direction
+  double velocityDirection[SIZE];
+  /// \brief Horizontal acceleration of each slot
+  double accelerationX[SIZE];
+  /// \brief Vertical acceleration of each slot
+  double accelerationY[SIZE];
+  /// \brief Direction each slot's acceleration was last given
+  ///        Only used while the acceleration is 0, so setting its strength later keeps the direction
+  double accelerationDirection[SIZE];
+  /// \brief Amount gravity affects each slot
+  double gravityScale[SIZE];
+  /// \brief Parent each slot moves while it's stepped by RigidbodyStorage::engine
+  ///        nullptr if the slot's Rigidbody is free, inactive, asleep or under another Engine
+  Object::Object *stepped[SIZE];
+  /// \brief Update rate group interval of each stepped slot
+  unsigned interval[SIZE];
+  /// \brief Update rate group offset of each stepped slot
+  unsigned offset[SIZE];
+  /// \brief Time Physics::Integrate steps each slot for
+  ///        0 if the slot isn't stepped this tick
+  double dt[SIZE];
+  /// \brief Distance Physics::Integrate moves each slot's Transform
+  double dx[SIZE], dy[SIZE];
+  /// \brief Number of slots that have been used
+  ///        Slots past this have never been used
+  unsigned used = 0;
+};
+
+/// \brief Every RigidbodyBlock and the slots free for reuse
+class RigidbodyStorage
+{
+public:
+  /// \brief Allocated blocks
+  ///        Blocks are never freed, so Rigidbodies can keep pointers to them
+  std::vector<std::unique_ptr<RigidbodyBlock>> blocks;
+  /// \brief Slots freed by destroyed Rigidbodies
+  std::vector<std::pair<RigidbodyBlock *, unsigned>> free;
+  /// \brief Engine the stepped masks were filled in for
+  ///        nullptr if they have to be filled in again
+  const Engine::Engine *engine = nullptr;
+  /// \brief Object::TreeVersion when the stepped masks were filled in
+  unsigned version = 0;
+  /// \brief Guards the lists so Rigidbodies can be created and destroyed by parallel update jobs
+  std::mutex mutex;
+};
+
+/// \brief Gets the storage shared by every Rigidbody
+///        Never destroyed, so Rigidbodies destroyed during static destruction can still free their slots
+/// \return Rigidbody storage
+static RigidbodyStorage &GetRigidbodyStorage()
+{
+  static RigidbodyStorage *storage = new RigidbodyStorage();
+  return *storage;
+}
+
+/// \brief Finds a slot for a new Rigidbody
+///        Reuses freed slots before filling the last block
+/// \param rb Rigidbody using the slot
+/// \param slot Set to the index of the slot
+/// \return Block holding the slot
+static RigidbodyBlock *AllocateRigidbody(Rigidbody *rb, unsigned &slot)
+{
+  RigidbodyStorage &s = GetRigidbodyStorage();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  RigidbodyBlock *block;
+  if (!s.free.empty())
+  {
+    block = s.free.back().first;
+    slot = s.free.back().second;
+    s.free.pop_back();
+  }
+  else
+  {
+    if (s.blocks.empty() || s.blocks.back()->used == RigidbodyBlock::SIZE)
+      s.blocks.emplace_back(new RigidbodyBlock());
+    block = s.blocks.back().get();
+    slot = block->used++;
+  }
+  block->owner[slot] = rb;
+  block->stepped[slot] = nullptr;
+  block->dt[slot] = 0.0;
+  s.engine = nullptr;
+  return block;
+}
+
+/// \brief Frees a Rigidbody's slot for reuse
+/// \param block Block holding the slot
+/// \param slot Index of the slot
+static void FreeRigidbody(RigidbodyBlock *block, unsigned slot)
+{
+  RigidbodyStorage &s = GetRigidbodyStorage();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  block->owner[slot] = nullptr;
+  block->stepped[slot] = nullptr;
+  block->dt[slot] = 0.0;
+  s.free.push_back(std::make_pair(block, slot));
+}
+
+/// \brief Fills in which slots engine steps, and their update rate groups
+///        Only has to be done again once the tree changes, since that's the only time any of it can change
+///        The caller must hold the storage's mutex
+/// \param s Rigidbody storage
+/// \param engine Engine being ticked
+static void FillSteppedMasks(RigidbodyStorage &s, const Engine::Engine *engine)
+{
+  for (std::unique_ptr<RigidbodyBlock> &block : s.blocks)
+  {
+    RigidbodyBlock &b = *block;
+    for (unsigned i = 0; i < b.used; ++i)
+    {
+      Rigidbody *rb = b.owner[i];
+      bool stepped = rb && rb->Parent() && rb->Active() && !rb->Sleeping() && rb->HasAncestor(engine);
+      b.stepped[i] = stepped ? rb->Parent() : nullptr;
+      b.interval[i] = stepped ? rb->UpdateInterval() : 1;
+      b.offset[i] = stepped ? rb->UpdateOffset() : 0;
+    }
+  }
+  s.engine = engine;
+  s.version = Object::Object::TreeVersion();
+}
+
+/// \brief Determines if a slot has any velocity or acceleration
+/// \param b Block holding the slot
+/// \param i Index of the slot
+/// \return True if the slot's Rigidbody is moving or accelerating
+static inline bool Moving(const RigidbodyBlock &b, unsigned i)
+{
+  return b.velocityX[i] != 0.0 || b.velocityY[i] != 0.0 || b.accelerationX[i] != 0.0 || b.accelerationY[i] != 0.0;
+}
+
+/// \brief Applies gravity, drag and acceleration to a slot's velocity
+///        Shared by Rigidbody::Step and Physics::Integrate so both step identically
+/// \param b Block holding the slot
+/// \param i Index of the slot
+/// \param dt Time to simulate in 60ths of a second
+/// \param gx Horizontal gravity
+/// \param gy Vertical gravity
+/// \param drag Drag factor
+/// \param dx Set to the horizontal distance to move
+/// \param dy Set to the vertical distance to move
+static inline void IntegrateSlot(RigidbodyBlock &b, unsigned i, double dt, double gx, double gy, double drag, double &dx, double &dy)
+{
+  double vx = std::abs(b.velocityX[i]) >= 0.001 ? b.velocityX[i] : 0.0;
+  double vy = std::abs(b.velocityY[i]) >= 0.001 ? b.velocityY[i] : 0.0;
+  vx += (b.accelerationX[i] + gx * b.gravityScale[i] - vx * drag) * dt;
+  vy += (b.accelerationY[i] + gy * b.gravityScale[i] - vy * drag) * dt;
+  b.velocityX[i] = vx;
+  b.velocityY[i] = vy;
+  dx = vx * dt;
+  dy = vy * dt;
+}
+
 Physics::Physics(Object *parent, std::string name)
     : Physics(1, GRAV_DIR::DOWN, parent, name)
 {
 }
 
 Physics::Physics(double strength, double direction, Object *parent, std::string name)
-    : Object(parent, name), _gravStrength(strength), _gravDirection(direction)
+    : Object(parent, name), _gravStrength(strength), _gravDirection(direction), _cellSize(DEFAULT_CELL_SIZE)
 {
+  // Steps after the children update
+  _updatesOwnChildren = true;
 }
 
 Physics::~Physics()
@@ -36,35 +214,81 @@ void Physics::operator()()
 {
   Object::operator()();
 
+  Engine::Engine *engine = Engine::Engine::Get();
+  if (!engine || engine->FixedTimestep() <= 0.0)
+    Step();
+  WakeHovered();
+}
+
+void Physics::WakeHovered()
+{
+  Engine::Engine *engine = Engine::Engine::Get();
+  if (!engine || engine->Headless())
+    return;
+  Input::Mouse &m = Input::GetMouse();
+  // Nothing can start hovering a sleeping Collider unless the mouse moved or clicked
+  if (m.dx == 0 && m.dy == 0 && !(m.left.pressed | m.middle.pressed | m.right.pressed))
+    return;
+  // The mouse belongs to this Engine's window, so Colliders under other Engines are left asleep
+  for (Collider *c : Aspen::Object::Registry<Collider>::Under(engine))
+    if (c->Sleeping() && c->Active() && c->Parent() &&
+        ((c->Parent()->Phases() & Aspen::Object::PHASES::MOUSE) || engine->Debug()) &&
+        c->InCollider(m.x, m.y))
+      c->Wake();
+}
+
+/// \brief Wakes a Collider that collided and the Object it belongs to
+/// \param c Collider that collided
+static void WakeColliding(Collider *c)
+{
+  c->Wake();
+  c->Parent()->Wake();
+}
+
+void Physics::Step()
+{
   Engine::Engine *engine = Engine::Engine::Get();
   if (engine)
   {
-    std::vector<Collider *> colliders = engine->FindDescendentsOfType<Collider>();
-    for (unsigned i = 0; i < colliders.size(); ++i)
-      if (!colliders[i]->Active())
-        colliders.erase(colliders.begin() + i--);
-    for (unsigned i = 0; i < colliders.size(); ++i)
+    _colliders.clear();
+    for (Collider *c : Aspen::Object::Registry<Collider>::Under(engine))
+      if (c->Active())
+        _colliders.push_back(c);
+    {
+      ASPEN_PROFILE_ZONE("Physics::FindPairs");
+      FindPairs(_colliders);
+    }
+    ASPEN_PROFILE_ZONE("Physics::TestPairs");
+    for (const std::pair<unsigned, unsigned> &p : _pairs)
     {
-      for (unsigned j = i + 1; j < colliders.size(); ++j)
+      Collider *a = _colliders[p.first];
+      Collider *b = _colliders[p.second];
+      if (a->HasAncestor(b->Parent()))
+        continue;
+      // Neither has moved since they fell asleep, so they can't have started touching
+      if (a->Sleeping() && b->Sleeping())
+        continue;
+      std::pair<Collision, Collision> c = a->TestCollision(b);
+      if (c.first.result == COLLISION_RESULT::SUCCESS)
       {
-        if (colliders[i]->HasAncestor(colliders[j]->Parent()))
-          continue;
-        std::pair<Collision, Collision> c = colliders[i]->TestCollision(colliders[j]);
+        WakeColliding(a);
+        WakeColliding(b);
+        if (a->Parent()->Phases() & Aspen::Object::PHASES::COLLISION)
+          a->Parent()->OnCollision(c.first);
+        if (b->Parent()->Phases() & Aspen::Object::PHASES::COLLISION)
+          b->Parent()->OnCollision(c.second);
+        a->ResolveCollision(c.first);
+        b->ResolveCollision(c.second);
+      }
+      else if (c.first.result == COLLISION_RESULT::CANNOT_HANDLE)
+      {
+        c = b->TestCollision(a);
         if (c.first.result == COLLISION_RESULT::SUCCESS)
         {
-          colliders[i]->Parent()->OnCollision(c.first);
-          colliders[j]->Parent()->OnCollision(c.second);
-          colliders[i]->ResolveCollision(c.first);
-          colliders[j]->ResolveCollision(c.second);
-        }
-        else if (c.first.result == COLLISION_RESULT::CANNOT_HANDLE)
-        {
-          c = colliders[j]->TestCollision(colliders[i]);
-          if (c.first.result == COLLISION_RESULT::SUCCESS)
-          {
-            colliders[j]->ResolveCollision(c.first);
-            colliders[i]->ResolveCollision(c.second);
-          }
+          WakeColliding(a);
+          WakeColliding(b);
+          b->ResolveCollision(c.first);
+          a->ResolveCollision(c.second);
         }
       }
     }
@@ -73,6 +297,147 @@ void Physics::operator()()
     Log::Error("%s must have an anscestor of type Engine::Engine!", Name().c_str());
 }
 
+void Physics::Integrate(Engine::Engine *engine)
+{
+  if (!engine)
+  {
+    Log::Error("%s must have an anscestor of type Engine::Engine!", Name().c_str());
+    return;
+  }
+  ASPEN_PROFILE_ZONE("Physics::Integrate");
+  double timestep = engine->FixedTimestep() * 60.0;
+  unsigned long long ticks = engine->Ticks();
+  double gx = GetGravityX();
+  double gy = GetGravityY();
+  RigidbodyStorage &s = GetRigidbodyStorage();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  if (s.engine != engine || s.version != TreeVersion())
+    FillSteppedMasks(s, engine);
+  for (std::unique_ptr<RigidbodyBlock> &block : s.blocks)
+  {
+    RigidbodyBlock &b = *block;
+    // Only moving Transforms touches anything outside the block
+    for (unsigned i = 0; i < b.used; ++i)
+      b.dt[i] = b.stepped[i] && (b.interval[i] <= 1 || (ticks + b.offset[i]) % b.interval[i] == 0)
+                    ? timestep * b.interval[i]
+                    : 0.0;
+    for (unsigned i = 0; i < b.used; ++i)
+      if (b.dt[i] > 0.0)
+        IntegrateSlot(b, i, b.dt[i], gx, gy, _drag, b.dx[i], b.dy[i]);
+    for (unsigned i = 0; i < b.used; ++i)
+    {
+      // Resting Rigidbodies leave their parents alone so they can fall asleep
+      if (b.dt[i] <= 0.0 || !Moving(b, i))
+        continue;
+      // A moving Rigidbody isn't idle
+      b.owner[i]->Wake();
+      Transform::Transform *tf = b.stepped[i]->GetTransform();
+      if (tf)
+        tf->ModifyPosition(b.dx[i], b.dy[i]);
+      else
+        Log::Warning("%s requires a parent with a Transform (see Object::GetTransform and Object::CreateTransform)!", b.owner[i]->Name().c_str());
+    }
+  }
+}
+
+/// \brief Packs a grid cell coordinate into a single spatial hash key
+/// \param x Cell x index
+/// \param y Cell y index
+/// \return Hash key
+static long long CellKey(int x, int y)
+{
+  return (static_cast<long long>(x) << 32) | static_cast<long long>(static_cast<unsigned>(y));
+}
+
+void Physics::FindPairs(const std::vector<Collider *> &colliders)
+{
+  _pairs.clear();
+  _unbounded.clear();
+  _proxies.resize(colliders.size());
+  unsigned usedCells = 0;
+  for (std::pair<const long long, std::vector<unsigned>> &cell : _grid)
+    cell.second.clear();
+
+  const double limit = double(std::numeric_limits<int>::max() / 2);
+  for (unsigned i = 0; i < colliders.size(); ++i)
+  {
+    BroadphaseProxy &p = _proxies[i];
+    p.collider = colliders[i];
+    p.bounded = p.collider->GetBounds(p.left, p.top, p.right, p.bottom);
+    if (p.bounded)
+    {
+      double x0 = std::floor(p.left / _cellSize),
+             y0 = std::floor(p.top / _cellSize),
+             x1 = std::floor(p.right / _cellSize),
+             y1 = std::floor(p.bottom / _cellSize);
+      // NaN fails every comparison, so this also rejects broken Transforms
+      if (!(x0 >= -limit && y0 >= -limit && x1 <= limit && y1 <= limit && x0 <= x1 && y0 <= y1) ||
+          (x1 - x0 + 1) * (y1 - y0 + 1) > MAX_PROXY_CELLS)
+        p.bounded = false;
+      else
+      {
+        p.x0 = int(x0);
+        p.y0 = int(y0);
+        p.x1 = int(x1);
+        p.y1 = int(y1);
+      }
+    }
+    if (!p.bounded)
+    {
+      _unbounded.push_back(i);
+      continue;
+    }
+    for (int x = p.x0; x <= p.x1; ++x)
+      for (int y = p.y0; y <= p.y1; ++y)
+      {
+        std::vector<unsigned> &cell = _grid[CellKey(x, y)];
+        if (cell.empty())
+          ++usedCells;
+        cell.push_back(i);
+      }
+  }
+
+  for (std::pair<const long long, std::vector<unsigned>> &cell : _grid)
+  {
+    const std::vector<unsigned> &members = cell.second;
+    if (members.size() < 2)
+      continue;
+    int cx = int(cell.first >> 32);
+    int cy = int(static_cast<unsigned>(cell.first & 0xFFFFFFFF));
+    for (unsigned a = 0; a < members.size(); ++a)
+    {
+      const BroadphaseProxy &pa = _proxies[members[a]];
+      for (unsigned b = a + 1; b < members.size(); ++b)
+      {
+        const BroadphaseProxy &pb = _proxies[members[b]];
+        // Only the first cell both proxies share reports the pair
+        if (std::max(pa.x0, pb.x0) != cx || std::max(pa.y0, pb.y0) != cy)
+          continue;
+        if (pa.right < pb.left || pb.right < pa.left || pa.bottom < pb.top || pb.bottom < pa.top)
+          continue;
+        _pairs.push_back(std::pair<unsigned, unsigned>(members[a], members[b]));
+      }
+    }
+  }
+
+  for (unsigned u : _unbounded)
+    for (unsigned i = 0; i < _proxies.size(); ++i)
+      if (i != u && (_proxies[i].bounded || i > u))
+        _pairs.push_back(std::pair<unsigned, unsigned>(std::min(u, i), std::max(u, i)));
+
+  std::sort(_pairs.begin(), _pairs.end());
+
+  // Drop buckets for cells nothing has used in a while so the map doesn't grow without bound
+  if (_grid.size() > 4 * usedCells + 1024)
+    for (std::unordered_map<long long, std::vector<unsigned>>::iterator it = _grid.begin(); it != _grid.end();)
+    {
+      if (it->second.empty())
+        it = _grid.erase(it);
+      else
+        ++it;
+    }
+}
+
 double Physics::GetGravityStrength()
 {
   return _gravStrength;
@@ -119,6 +484,17 @@ void Physics::SetDrag(double drag)
   _drag = drag;
 }
 
+double Physics::GetCellSize()
+{
+  return _cellSize;
+}
+
+void Physics::SetCellSize(double size)
+{
+  if (size > 0)
+    _cellSize = size;
+}
+
 void Physics::PopulateDebugger()
 {
   static float gs;
@@ -133,6 +509,11 @@ void Physics::PopulateDebugger()
   _gravDirection = gd;
   ImGui::SliderFloat("Drag", &d, 0.0f, 1.0f);
   _drag = d;
+  static float cs;
+  cs = _cellSize;
+  ImGui::DragFloat("Cell Size", &cs, 1.0f, 1.0f, 4096.0f);
+  SetCellSize(cs);
+  ImGui::Text("Broadphase Pairs: %d", int(_pairs.size()));
   Object::PopulateDebugger();
 }
 
@@ -144,15 +525,53 @@ Rigidbody::Rigidbody(Object *parent, std::string name)
 }
 
 Rigidbody::Rigidbody(double mass, Object *parent, std::string name)
-    : Object(parent, name), _mass(mass), _velocityStrength(0), _velocityDirection(0), _accelerationStrength(0), _accelerationDirection(0), _gravityScale(1)
+    : Object(parent, name), _registryEntry(this)
 {
+  _block = AllocateRigidbody(this, _slot);
+  _block->mass[_slot] = mass;
+  _block->velocityX[_slot] = 0;
+  _block->velocityY[_slot] = 0;
+  _block->velocityDirection[_slot] = 0;
+  _block->accelerationX[_slot] = 0;
+  _block->accelerationY[_slot] = 0;
+  _block->accelerationDirection[_slot] = 0;
+  _block->gravityScale[_slot] = 1;
+}
+
+Rigidbody::Rigidbody(const Rigidbody &other, Object *parent)
+    : Object(other, parent), _registryEntry(this)
+{
+  _block = AllocateRigidbody(this, _slot);
+  _block->mass[_slot] = other._block->mass[other._slot];
+  _block->velocityX[_slot] = other._block->velocityX[other._slot];
+  _block->velocityY[_slot] = other._block->velocityY[other._slot];
+  _block->velocityDirection[_slot] = other._block->velocityDirection[other._slot];
+  _block->accelerationX[_slot] = other._block->accelerationX[other._slot];
+  _block->accelerationY[_slot] = other._block->accelerationY[other._slot];
+  _block->accelerationDirection[_slot] = other._block->accelerationDirection[other._slot];
+  _block->gravityScale[_slot] = other._block->gravityScale[other._slot];
+}
+
+Object::Object *Rigidbody::Clone(Object *parent) const
+{
+  return new Rigidbody(*this, parent);
 }
 
 Rigidbody::~Rigidbody()
 {
+  FreeRigidbody(_block, _slot);
 }
 
 void Rigidbody::operator()()
+{
+  Engine::Engine *engine = Engine::Engine::Get();
+  if (_parent && (!engine || engine->FixedTimestep() <= 0.0) && UpdateDue())
+    Step(UpdateDeltaTime() * 60.0);
+
+  Object::operator()();
+}
+
+void Rigidbody::Step(double dt)
 {
   if (_parent)
   {
@@ -162,29 +581,19 @@ void Rigidbody::operator()()
       Physics *physics = engine->FindChildOfType<Physics>();
       if (physics)
       {
-        Time::Time *time = Time::Time::Get();
-        double dt;
-        if (time)
-          dt = time->DeltaTime() * 60.0;
-        else
-          dt = 1.0;
-
-        //_velocityStrength *= physics->GetDrag() * dt;
-        //SetCartesianVelocity(GetVelocityX() + GetAccelerationX() * dt, GetVelocityY() + GetAccelerationY() * dt);
-        //SetCartesianAcceleration(GetAccelerationX() + physics->GetGravityX(), GetAccelerationY() + physics->GetGravityY());
-        double vx = GetVelocityX();
-        double vy = GetVelocityY();
-        vx = std::abs(vx) >= 0.001 ? vx : 0.0;
-        vy = std::abs(vy) >= 0.001 ? vy : 0.0;
-        double ax = (GetAccelerationX() + physics->GetGravityX() * _gravityScale - vx * physics->GetDrag()) * dt;
-        double ay = (GetAccelerationY() + physics->GetGravityY() * _gravityScale - vy * physics->GetDrag()) * dt;
-        SetCartesianVelocity(vx + ax, vy + ay);
+        double dx, dy;
+        IntegrateSlot(*_block, _slot, dt, physics->GetGravityX(), physics->GetGravityY(), physics->GetDrag(), dx, dy);
+        // Resting Rigidbodies leave their parents alone so they can fall asleep
+        if (!Moving(*_block, _slot))
+          return;
+        // A moving Rigidbody isn't idle
+        Wake();
 
         Transform::Transform *tf = _parent->GetTransform();
         if (tf)
-          tf->ModifyPosition(GetVelocityX(), GetVelocityY());
+          tf->ModifyPosition(dx, dy);
         else
-          Log::Warning("%s requires a parent with a Transform child!", Name().c_str());
+          Log::Warning("%s requires a parent with a Transform (see Object::GetTransform and Object::CreateTransform)!", Name().c_str());
       }
       else
         Log::Error("%s requires an ancestor Engine with a Physics child!", Name().c_str());
@@ -192,175 +601,194 @@ void Rigidbody::operator()()
     else
       Log::Error("%s requires an ancestor Engine with a Physics child!", Name().c_str());
   }
-
-  Object::operator()();
 }
 
 double Rigidbody::GetMass()
 {
-  return _mass;
+  return _block->mass[_slot];
 }
 
 void Rigidbody::SetMass(double mass)
 {
-  _mass = mass;
+  _block->mass[_slot] = mass;
 }
 
 double Rigidbody::GetVelocityStrength()
 {
-  return _velocityStrength;
+  return std::sqrt(GetVelocityX() * GetVelocityX() + GetVelocityY() * GetVelocityY());
 }
 
 double Rigidbody::GetVelocityDirection()
 {
-  return _velocityDirection;
+  if (GetVelocityX() == 0.0 && GetVelocityY() == 0.0)
+    return _block->velocityDirection[_slot];
+  return std::atan2(GetVelocityY(), GetVelocityX());
 }
 
 double Rigidbody::GetVelocityX()
 {
-  return _velocityStrength * std::cos(_velocityDirection);
+  return _block->velocityX[_slot];
 }
 
 double Rigidbody::GetVelocityY()
 {
-  return _velocityStrength * std::sin(_velocityDirection);
+  return _block->velocityY[_slot];
 }
 
 void Rigidbody::SetVelocityStrength(double strength)
 {
-  _velocityStrength = strength;
+  SetVelocity(strength, GetVelocityDirection());
 }
 
 void Rigidbody::SetVelocityDirection(double direction)
 {
-  _velocityDirection = direction;
+  SetVelocity(GetVelocityStrength(), direction);
 }
 
 void Rigidbody::SetVelocity(double strength, double direction)
 {
-  _velocityStrength = strength;
-  _velocityDirection = direction;
+  _block->velocityX[_slot] = strength * std::cos(direction);
+  _block->velocityY[_slot] = strength * std::sin(direction);
+  _block->velocityDirection[_slot] = direction;
 }
 
 void Rigidbody::SetCartesianVelocity(double x, double y)
 {
-  _velocityDirection = std::atan2(y, x);
-  _velocityStrength = std::sqrt(x * x + y * y);
+  _block->velocityX[_slot] = x;
+  _block->velocityY[_slot] = y;
 }
 
 double Rigidbody::GetAccelerationStrength()
 {
-  return _accelerationStrength;
+  return std::sqrt(GetAccelerationX() * GetAccelerationX() + GetAccelerationY() * GetAccelerationY());
 }
 
 double Rigidbody::GetAccelerationDirection()
 {
-  return _accelerationDirection;
+  if (GetAccelerationX() == 0.0 && GetAccelerationY() == 0.0)
+    return _block->accelerationDirection[_slot];
+  return std::atan2(GetAccelerationY(), GetAccelerationX());
 }
 
 double Rigidbody::GetAccelerationX()
 {
-  return _accelerationStrength * std::cos(_accelerationDirection);
+  return _block->accelerationX[_slot];
 }
 
 double Rigidbody::GetAccelerationY()
 {
-  return _accelerationStrength * std::sin(_accelerationDirection);
+  return _block->accelerationY[_slot];
 }
 
 void Rigidbody::SetAccelerationStrength(double strength)
 {
-  _accelerationStrength = strength;
+  SetAcceleration(strength, GetAccelerationDirection());
 }
 
 void Rigidbody::SetAccelerationDirection(double direction)
 {
-  _accelerationDirection = direction;
+  SetAcceleration(GetAccelerationStrength(), direction);
 }
 
 void Rigidbody::SetAcceleration(double strength, double direction)
 {
-  _accelerationDirection = direction;
-  _accelerationStrength = strength;
+  _block->accelerationX[_slot] = strength * std::cos(direction);
+  _block->accelerationY[_slot] = strength * std::sin(direction);
+  _block->accelerationDirection[_slot] = direction;
 }
 
 void Rigidbody::SetCartesianAcceleration(double x, double y)
 {
-  _accelerationDirection = std::atan2(y, x);
-  _accelerationStrength = std::sqrt(x * x + y * y);
+  _block->accelerationX[_slot] = x;
+  _block->accelerationY[_slot] = y;
 }
 
 void Rigidbody::ApplyForce(double force, double angle)
 {
-  force /= _mass;
-  double fx = std::cos(angle) * force;
-  double fy = std::sin(angle) * force;
-  SetCartesianVelocity(GetVelocityX() + fx, GetVelocityY() + fy);
+  force /= _block->mass[_slot];
+  SetCartesianVelocity(GetVelocityX() + std::cos(angle) * force, GetVelocityY() + std::sin(angle) * force);
 }
 
 void Rigidbody::ApplyCartesianForce(double x, double y)
 {
-  SetCartesianVelocity(GetVelocityX() + x / _mass, GetVelocityY() + y / _mass);
+  double mass = _block->mass[_slot];
+  SetCartesianVelocity(GetVelocityX() + x / mass, GetVelocityY() + y / mass);
 }
 
 double Rigidbody::GetGravityScale()
 {
-  return _gravityScale;
+  return _block->gravityScale[_slot];
 }
 
 void Rigidbody::SetGravityScale(double scale)
 {
-  _gravityScale = scale;
+  _block->gravityScale[_slot] = scale;
 }
 
 void Rigidbody::PopulateDebugger()
 {
+  RigidbodyBlock &b = *_block;
   static float m;
-  m = _mass;
+  m = b.mass[_slot];
   static float vs;
-  vs = _velocityStrength;
+  vs = GetVelocityStrength();
   static float vd;
-  vd = _velocityDirection;
+  vd = GetVelocityDirection();
   ImGui::DragFloat("Mass", &m, 0.1f, 0.1f, 10000.0f);
-  _mass = m;
-  ImGui::DragFloat("Velocity Strength", &vs, 0.1f);
-  _velocityStrength = vs;
-  ImGui::SliderFloat("Velocity Direction", &vd, 0.0f, float(2 * M_PI));
-  _velocityDirection = vd;
+  b.mass[_slot] = m;
+  bool velocityChanged = ImGui::DragFloat("Velocity Strength", &vs, 0.1f);
+  velocityChanged |= ImGui::SliderFloat("Velocity Direction", &vd, 0.0f, float(2 * M_PI));
+  if (velocityChanged)
+    SetVelocity(vs, vd);
   ImGui::Text("Cartesian Velocity: (%.4f, %.4f)", GetVelocityX(), GetVelocityY());
   Engine::Engine *engine = Engine::Engine::Get();
   if (engine)
   {
     Physics *physics = engine->FindChildOfType<Physics>();
     if (physics)
-      ImGui::Text("VDrag: %.4f", _velocityStrength * physics->GetDrag());
+      ImGui::Text("VDrag: %.4f", GetVelocityStrength() * physics->GetDrag());
   }
   static float as;
-  as = _accelerationStrength;
+  as = GetAccelerationStrength();
   static float ad;
-  ad = _accelerationDirection;
-  ImGui::DragFloat("Acceleration Strength", &as, 0.1f);
-  _accelerationStrength = as;
-  ImGui::SliderFloat("Acceleration Direction", &ad, 0.0f, float(2 * M_2_PI));
-  _accelerationDirection = ad;
+  ad = GetAccelerationDirection();
+  bool accelerationChanged = ImGui::DragFloat("Acceleration Strength", &as, 0.1f);
+  accelerationChanged |= ImGui::SliderFloat("Acceleration Direction", &ad, 0.0f, float(2 * M_2_PI));
+  if (accelerationChanged)
+    SetAcceleration(as, ad);
   Object::PopulateDebugger();
 }
 
 /////////////////////////////////////////////////////////
 
 Collider::Collider(Object *parent, std::string name)
-    : Object(parent, name), _trigger(false)
+    : Object(parent, name), _trigger(false), _registryEntry(this), _transformComponent(this)
+{
+}
+
+Collider::Collider(const Collider &other, Object *parent)
+    : Object(other, parent), _trigger(other._trigger), _mouseOver(false), _registryEntry(this), _transformComponent(this)
+{
+  _transformComponent = other._transformComponent;
+}
+
+Object::Object *Collider::Clone(Object *parent) const
 {
-  CreateChild<Transform::Transform>();
+  return new Collider(*this, parent);
 }
 
 void Collider::operator()()
 {
-  if (Parent())
+  Engine::Engine *engine = Engine::Engine::Get();
+  // Middle clicking opens the Debugger, so debugging engines test every collider
+  if (Parent() && !(engine && engine->Headless()) &&
+      ((Parent()->Phases() & Aspen::Object::PHASES::MOUSE) || (engine && engine->Debug())))
   {
     Input::Mouse &m = Input::GetMouse();
     if (InCollider(m.x, m.y))
     {
+      // Stays awake while the mouse is over it
+      Wake();
       if (!_mouseOver)
       {
         _mouseOver = true;
@@ -430,6 +858,11 @@ bool Collider::InCollider(int x, int y)
   return x == tf->GetXPosition() && y == tf->GetYPosition();
 }
 
+bool Collider::GetBounds(double &left, double &top, double &right, double &bottom)
+{
+  return false;
+}
+
 bool Collider::IsTrigger()
 {
   return _trigger;
@@ -458,6 +891,16 @@ CircleCollider::CircleCollider(double radius, Object *parent, std::string name)
 {
 }
 
+CircleCollider::CircleCollider(const CircleCollider &other, Object *parent)
+    : Collider(other, parent), _radius(other._radius)
+{
+}
+
+Object::Object *CircleCollider::Clone(Object *parent) const
+{
+  return new CircleCollider(*this, parent);
+}
+
 std::pair<Collision, Collision> CircleCollider::TestCollision(Collider *other)
 {
   std::pair<Collision, Collision> c(Collision(other), Collision(this));
@@ -478,11 +921,11 @@ std::pair<Collision, Collision> CircleCollider::TestCollision(Collider *other)
         return c;
       }
     }
-    Transform::Transform *otf = GetTransform();
+    Transform::Transform *otf = other->GetTransform();
     if (!otf)
     {
-      if (Parent())
-        otf = Parent()->GetTransform();
+      if (other->Parent())
+        otf = other->Parent()->GetTransform();
       if (!otf)
       {
         c.first.result = COLLISION_RESULT::FAILURE;
@@ -614,6 +1057,23 @@ bool CircleCollider::InCollider(int x, int y)
   return d2 <= r2;
 }
 
+bool CircleCollider::GetBounds(double &left, double &top, double &right, double &bottom)
+{
+  Transform::Transform *tf = GetTransform();
+  if (!tf && Parent())
+    tf = Parent()->GetTransform();
+  if (!tf)
+    return false;
+  double x = tf->GetXPosition(),
+         y = tf->GetYPosition();
+  double r = std::abs(_radius * (tf->GetXScale() + tf->GetYScale()) * 0.5f);
+  left = x - r;
+  right = x + r;
+  top = y - r;
+  bottom = y + r;
+  return true;
+}
+
 double CircleCollider::GetRadius()
 {
   return _radius;
@@ -645,6 +1105,16 @@ AABBCollider::AABBCollider(double width, double height, Object *parent, std::str
 {
 }
 
+AABBCollider::AABBCollider(const AABBCollider &other, Object *parent)
+    : Collider(other, parent), _width(other._width), _height(other._height)
+{
+}
+
+Object::Object *AABBCollider::Clone(Object *parent) const
+{
+  return new AABBCollider(*this, parent);
+}
+
 std::pair<Collision, Collision> AABBCollider::TestCollision(Collider *other)
 {
   std::pair<Collision, Collision> c(Collision(other), Collision(this));
@@ -899,6 +1369,25 @@ bool AABBCollider::InCollider(int x, int y)
   return x <= GetWidth() && y <= GetHeight();
 }
 
+bool AABBCollider::GetBounds(double &left, double &top, double &right, double &bottom)
+{
+  Transform::Transform *tf = GetTransform();
+  if (!tf && Parent())
+    tf = Parent()->GetTransform();
+  if (!tf)
+    return false;
+  double x = tf->GetXPosition(),
+         y = tf->GetYPosition();
+  double hw = GetWidth() * tf->GetXScale() / 2.0f,
+         hh = GetHeight() * tf->GetYScale() / 2.0f;
+  double r = std::sqrt(hw * hw + hh * hh);
+  left = x - r;
+  right = x + r;
+  top = y - r;
+  bottom = y + r;
+  return true;
+}
+
 double AABBCollider::GetWidth()
 {
   if (GetTransform())
@@ -0,0 +1,181 @@
+#define __PROFILER_CPP
+
+#include "Profiler.hpp"
+#include "Log.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#undef __PROFILER_CPP
+
+namespace Aspen
+{
+namespace Profiler
+{
+const unsigned RING_SIZE = 1 << 16;
+
+/// \brief Recorded zone
+class Record
+{
+public:
+  /// \brief Name of the zone
+  char name[NAME_LENGTH];
+  /// \brief Time the zone started in nanoseconds since the profiler started
+  unsigned long long start;
+  /// \brief Time the zone ended in nanoseconds since the profiler started
+  unsigned long long end;
+  /// \brief Frame the zone ended in
+  unsigned long long frame;
+};
+
+/// \brief Ring buffer of zones recorded by a single thread
+class ThreadBuffer
+{
+public:
+  /// \brief Index of the thread in the order threads first recorded a zone
+  unsigned thread;
+  /// \brief Total number of zones ever recorded
+  ///        The newest zone is at (written - 1) % RING_SIZE
+  std::atomic<unsigned long long> written;
+  /// \brief Recorded zones
+  std::vector<Record> records;
+
+  /// \brief Constructor
+  /// \param index Index of the thread
+  ThreadBuffer(unsigned index)
+      : thread(index), written(0), records(RING_SIZE)
+  {
+  }
+};
+
+/// \brief Time the profiler started
+static const std::chrono::steady_clock::time_point _epoch = std::chrono::steady_clock::now();
+/// \brief Current frame
+static std::atomic<unsigned long long> _frame(0);
+/// \brief Guards _buffers
+static std::mutex _buffersMutex;
+/// \brief Every thread's ring buffer
+///        Buffers are kept after their thread exits so its zones can still be written
+static std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+/// \brief This thread's ring buffer
+static thread_local ThreadBuffer *_buffer = nullptr;
+
+/// \brief Gets the time since the profiler started
+/// \return Time in nanoseconds
+static unsigned long long Now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _epoch).count();
+}
+
+/// \brief Gets this thread's ring buffer
+///        Creates it the first time it's needed
+/// \return This thread's ring buffer
+static ThreadBuffer *GetBuffer()
+{
+  if (!_buffer)
+  {
+    std::lock_guard<std::mutex> lock(_buffersMutex);
+    _buffers.emplace_back(new ThreadBuffer(unsigned(_buffers.size())));
+    _buffer = _buffers.back().get();
+  }
+  return _buffer;
+}
+
+ScopedZone::ScopedZone(const char *name)
+{
+  std::strncpy(_name, name, NAME_LENGTH - 1);
+  _name[NAME_LENGTH - 1] = '\0';
+  _start = Now();
+}
+
+ScopedZone::ScopedZone(const std::string &name)
+    : ScopedZone(name.c_str())
+{
+}
+
+ScopedZone::~ScopedZone()
+{
+  ThreadBuffer *buffer = GetBuffer();
+  unsigned long long index = buffer->written.load(std::memory_order_relaxed);
+  Record &r = buffer->records[index % RING_SIZE];
+  std::memcpy(r.name, _name, NAME_LENGTH);
+  r.start = _start;
+  r.end = Now();
+  r.frame = _frame.load(std::memory_order_relaxed);
+  buffer->written.store(index + 1, std::memory_order_release);
+}
+
+void NewFrame()
+{
+  ++_frame;
+}
+
+unsigned long long Frame()
+{
+  return _frame;
+}
+
+/// \brief Writes a string as a JSON string literal
+/// \param out Stream to write to
+/// \param s String to write
+static void WriteJSONString(std::ostream &out, const char *s)
+{
+  out << '"';
+  for (; *s; ++s)
+  {
+    if (*s == '"' || *s == '\\')
+      out << '\\' << *s;
+    else if (static_cast<unsigned char>(*s) < 0x20)
+      out << ' ';
+    else
+      out << *s;
+  }
+  out << '"';
+}
+
+bool WriteTrace(std::string path, unsigned frames)
+{
+  std::ofstream out(path.c_str(), std::ios_base::out | std::ios_base::trunc);
+  if (!out.is_open())
+  {
+    Log::Error("Profiler couldn't open %s to write a trace", path.c_str());
+    return false;
+  }
+  unsigned long long current = _frame;
+  unsigned long long first = (frames == 0 || frames > current) ? 0 : current - frames;
+
+  out << std::fixed << std::setprecision(3);
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool comma = false;
+  std::lock_guard<std::mutex> lock(_buffersMutex);
+  for (std::unique_ptr<ThreadBuffer> &buffer : _buffers)
+  {
+    unsigned long long written = buffer->written.load(std::memory_order_acquire);
+    unsigned long long oldest = written > RING_SIZE ? written - RING_SIZE : 0;
+    for (unsigned long long i = oldest; i < written; ++i)
+    {
+      const Record &r = buffer->records[i % RING_SIZE];
+      if (r.frame < first)
+        continue;
+      if (comma)
+        out << ',';
+      comma = true;
+      out << "\n{\"name\":";
+      WriteJSONString(out, r.name);
+      out << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->thread
+          << ",\"ts\":" << r.start / 1000.0
+          << ",\"dur\":" << (r.end - r.start) / 1000.0
+          << ",\"args\":{\"frame\":" << r.frame << "}}";
+    }
+  }
+  out << "\n]}\n";
+  Log::Info("Profiler wrote a trace to %s", path.c_str());
+  return true;
+}
+} // namespace Profiler
+} // namespace Aspen
@@ -0,0 +1,492 @@
+#define __SCENE_CPP
+
+#include "Scene.hpp"
+#include "Graphics.hpp"
+#include "Physics.hpp"
+#include "Transform.hpp"
+#include "Log.hpp"
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#ifdef __WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#undef __SCENE_CPP
+
+namespace Aspen
+{
+namespace Scene
+{
+static_assert(sizeof(Header) == 16, "Scene headers must match the file format");
+static_assert(sizeof(Record) == 64, "Scene records must match the file format");
+
+/// \brief Magic number at the start of every scene file
+static const char MAGIC[4] = {'A', 'S', 'C', 'N'};
+
+/// \brief Read-only memory mapping of a whole file
+class MappedFile
+{
+public:
+  /// \brief Start of the file's contents
+  ///        nullptr if the file couldn't be mapped
+  const char *data;
+  /// \brief Size of the file
+  std::size_t size;
+#ifdef __WIN32
+  /// \brief Mapping of the file
+  HANDLE mapping;
+#endif
+
+  /// \brief Constructor
+  ///        Maps the file
+  /// \param path Path of the file to map
+  MappedFile(const std::string &path)
+      : data(nullptr), size(0)
+  {
+#ifdef __WIN32
+    mapping = nullptr;
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+      return;
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+    {
+      mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (mapping)
+      {
+        data = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        size = std::size_t(fileSize.QuadPart);
+      }
+    }
+    // The mapping keeps the file open
+    CloseHandle(file);
+#else
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0)
+      return;
+    struct stat info;
+    if (fstat(file, &info) == 0 && info.st_size > 0)
+    {
+      void *p = mmap(nullptr, std::size_t(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+      if (p != MAP_FAILED)
+      {
+        data = static_cast<const char *>(p);
+        size = std::size_t(info.st_size);
+        // Records are read front to back exactly once
+        madvise(p, size, MADV_SEQUENTIAL);
+      }
+    }
+    // The mapping keeps the file open
+    close(file);
+#endif
+  }
+  /// \brief Destructor
+  ///        Unmaps the file
+  ~MappedFile()
+  {
+#ifdef __WIN32
+    if (data)
+      UnmapViewOfFile(data);
+    if (mapping)
+      CloseHandle(mapping);
+#else
+    if (data)
+      munmap(const_cast<char *>(data), size);
+#endif
+  }
+  /// \brief Copying is not allowed
+  MappedFile(const MappedFile &) = delete;
+  /// \brief Copying is not allowed
+  MappedFile &operator=(const MappedFile &) = delete;
+};
+
+/// \brief Gets the TYPE of an Object
+/// \param o Object to check
+/// \return TYPE of o
+///         TYPE::COUNT if o's exact type can't be saved
+static std::uint32_t TypeOf(const Object::Object *o)
+{
+  const std::type_info &type = typeid(*o);
+  if (type == typeid(Object::Object))
+    return TYPE::OBJECT;
+  if (type == typeid(Graphics::Rectangle))
+    return TYPE::RECTANGLE;
+  if (type == typeid(Graphics::Point))
+    return TYPE::POINT;
+  if (type == typeid(Graphics::Line))
+    return TYPE::LINE;
+  if (type == typeid(Graphics::Sprite))
+    return TYPE::SPRITE;
+  if (type == typeid(Physics::Rigidbody))
+    return TYPE::RIGIDBODY;
+  if (type == typeid(Physics::CircleCollider))
+    return TYPE::CIRCLE_COLLIDER;
+  if (type == typeid(Physics::AABBCollider))
+    return TYPE::AABB_COLLIDER;
+  return TYPE::COUNT;
+}
+
+/// \brief Packs a Color the way Records store it
+/// \param c Color to pack
+/// \return Color as 0xRRGGBBAA
+static std::uint32_t PackColor(const Graphics::Color &c)
+{
+  return (std::uint32_t(c.Red()) << 24) | (std::uint32_t(c.Green()) << 16) | (std::uint32_t(c.Blue()) << 8) | std::uint32_t(c.Alpha());
+}
+
+/// \brief Unpacks a Color stored in a Record
+/// \param c Color as 0xRRGGBBAA
+/// \return Unpacked Color
+static Graphics::Color UnpackColor(std::uint32_t c)
+{
+  return Graphics::Color((unsigned char)(c >> 24), (unsigned char)(c >> 16), (unsigned char)(c >> 8), (unsigned char)c);
+}
+
+/// \brief Fills out the Record of an Object
+/// \param o Object to save
+/// \param r Record to fill out with everything but its parent and strings
+static void FillRecord(Object::Object *o, Record &r)
+{
+  Transform::Transform *tf = o->GetTransform();
+  if (tf)
+  {
+    r.flags |= RECORD_FLAGS::TRANSFORM;
+    r.x = tf->GetLocalXPosition();
+    r.y = tf->GetLocalYPosition();
+    r.rotation = float(tf->GetLocalRotation());
+    r.xScale = tf->GetLocalXScale();
+    r.yScale = tf->GetLocalYScale();
+  }
+  Graphics::Geometry *geometry = dynamic_cast<Graphics::Geometry *>(o);
+  if (geometry)
+  {
+    r.color = PackColor(geometry->Color());
+    if (geometry->Fill())
+      r.flags |= RECORD_FLAGS::FILL;
+  }
+  Physics::Collider *collider = dynamic_cast<Physics::Collider *>(o);
+  if (collider && collider->IsTrigger())
+    r.flags |= RECORD_FLAGS::TRIGGER;
+  switch (r.type)
+  {
+  case TYPE::RECTANGLE:
+  {
+    SDL_Rect &rect = static_cast<Graphics::Rectangle *>(o)->GetRect();
+    r.params[0] = float(rect.x);
+    r.params[1] = float(rect.y);
+    r.params[2] = float(rect.w);
+    r.params[3] = float(rect.h);
+    break;
+  }
+  case TYPE::POINT:
+  {
+    SDL_Point &point = static_cast<Graphics::Point *>(o)->GetPoint();
+    r.params[0] = float(point.x);
+    r.params[1] = float(point.y);
+    break;
+  }
+  case TYPE::LINE:
+  {
+    Graphics::Line *line = static_cast<Graphics::Line *>(o);
+    r.params[0] = float(line->GetStart().x);
+    r.params[1] = float(line->GetStart().y);
+    r.params[2] = float(line->GetEnd().x);
+    r.params[3] = float(line->GetEnd().y);
+    r.params[4] = line->GetCenter();
+    break;
+  }
+  case TYPE::RIGIDBODY:
+  {
+    Physics::Rigidbody *rb = static_cast<Physics::Rigidbody *>(o);
+    r.params[0] = float(rb->GetMass());
+    r.params[1] = float(rb->GetGravityScale());
+    break;
+  }
+  case TYPE::CIRCLE_COLLIDER:
+    r.params[0] = float(static_cast<Physics::CircleCollider *>(o)->GetRadius());
+    break;
+  case TYPE::AABB_COLLIDER:
+  {
+    Physics::AABBCollider *aabb = static_cast<Physics::AABBCollider *>(o);
+    r.params[0] = float(aabb->GetWidth());
+    r.params[1] = float(aabb->GetHeight());
+    break;
+  }
+  }
+}
+
+bool Save(Object::Object *root, std::string path)
+{
+  if (!root)
+    return false;
+  std::vector<Record> records;
+  std::string strings;
+  std::unordered_map<std::string, std::uint32_t> offsets;
+  // Strings used by many Objects, such as names and sprite paths, are only stored once
+  auto addString = [&strings, &offsets](const std::string &s) -> std::uint32_t {
+    std::pair<std::unordered_map<std::string, std::uint32_t>::iterator, bool> it = offsets.emplace(s, std::uint32_t(strings.size()));
+    if (it.second)
+      strings.append(s.c_str(), s.size() + 1);
+    return it.first->second;
+  };
+  addString("");
+
+  // Pairs of an Object and the index of its parent's Record
+  // Children are pushed in reverse so Records come out in pre-order
+  std::vector<std::pair<Object::Object *, std::uint32_t>> stack;
+  for (unsigned i = root->ChildrenCount(); i-- > 0;)
+    stack.emplace_back((*root)[i], ROOT);
+  while (!stack.empty())
+  {
+    Object::Object *o = stack.back().first;
+    std::uint32_t parent = stack.back().second;
+    stack.pop_back();
+    if (!o->Valid())
+      continue;
+    std::uint32_t type = TypeOf(o);
+    if (type == TYPE::COUNT)
+    {
+      Log::Warning("%s can't be saved in a scene, so it and its children were left out", o->Name().c_str());
+      continue;
+    }
+    Record r;
+    std::memset(&r, 0, sizeof(r));
+    r.type = type;
+    r.parent = parent;
+    r.name = addString(o->Name());
+    r.xScale = 1;
+    r.yScale = 1;
+    r.color = 0xFFFFFFFF;
+    if (type == TYPE::SPRITE)
+      r.path = addString(static_cast<Graphics::Sprite *>(o)->GetPath());
+    FillRecord(o, r);
+    std::uint32_t index = std::uint32_t(records.size());
+    records.push_back(r);
+    for (unsigned i = o->ChildrenCount(); i-- > 0;)
+      stack.emplace_back((*o)[i], index);
+  }
+
+  std::ofstream out(path.c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+  if (!out.is_open())
+  {
+    Log::Error("Couldn't open %s to save a scene", path.c_str());
+    return false;
+  }
+  Header header;
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.objectCount = std::uint32_t(records.size());
+  header.stringBytes = std::uint32_t(strings.size());
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char *>(records.data()), std::streamsize(records.size() * sizeof(Record)));
+  out.write(strings.data(), std::streamsize(strings.size()));
+  if (!out)
+  {
+    Log::Error("Couldn't write the scene to %s", path.c_str());
+    return false;
+  }
+  Log::Info("Saved %u Objects to %s", header.objectCount, path.c_str());
+  return true;
+}
+
+/// \brief Determines if a float read from a scene can be converted to an int
+/// \param f Value to check
+/// \return True if f is finite and in the range of an int
+static bool FitsInt(float f)
+{
+  // Both bounds are exact floats, and NaN fails both comparisons
+  return f >= -2147483648.0f && f < 2147483648.0f;
+}
+
+/// \brief Determines if the values of a Record can be used to create its Object
+/// \param r Record to check
+/// \return True if every value is finite and every value converted to an int fits in one
+static bool ValidValues(const Record &r)
+{
+  const float *p = r.params;
+  for (unsigned i = 0; i < 5; ++i)
+    if (!std::isfinite(p[i]))
+      return false;
+  if (!std::isfinite(r.x) || !std::isfinite(r.y) || !std::isfinite(r.rotation) ||
+      !std::isfinite(r.xScale) || !std::isfinite(r.yScale))
+    return false;
+  switch (r.type)
+  {
+  case TYPE::RECTANGLE:
+  case TYPE::LINE:
+    return FitsInt(p[0]) && FitsInt(p[1]) && FitsInt(p[2]) && FitsInt(p[3]);
+  case TYPE::POINT:
+    return FitsInt(p[0]) && FitsInt(p[1]);
+  case TYPE::RIGIDBODY:
+    // Forces are divided by the mass
+    return p[0] > 0.0f;
+  default:
+    return true;
+  }
+}
+
+/// \brief Creates an Object the way Object::CreateChild does
+///        Only the hooks T overrides take part in their phases, and T's children are left to the update pass
+///        only if its operator() allows it
+/// \tparam T Type of Object to create
+/// \param args Constructor parameters
+/// \return New Object
+template <typename T, typename... Args>
+static T *Create(Args &&...args)
+{
+  T *o = new T(std::forward<Args>(args)...);
+  o->Phases(Object::Object::PhasesOf<T>());
+  if (!Object::Object::LeavesChildrenToPass<T>())
+    o->UpdatesOwnChildren(true);
+  return o;
+}
+
+/// \brief Creates the Object of a Record
+/// \param r Record to create from
+/// \param parent Parent of the new Object
+/// \param strings String table
+/// \return New Object
+static Object::Object *CreateObject(const Record &r, Object::Object *parent, const char *strings)
+{
+  std::string name(strings + r.name);
+  const float *p = r.params;
+  switch (r.type)
+  {
+  case TYPE::RECTANGLE:
+    return Create<Graphics::Rectangle>(SDL_Rect{int(p[0]), int(p[1]), int(p[2]), int(p[3])}, UnpackColor(r.color), (r.flags & RECORD_FLAGS::FILL) != 0, parent, name);
+  case TYPE::POINT:
+    return Create<Graphics::Point>(SDL_Point{int(p[0]), int(p[1])}, UnpackColor(r.color), parent, name);
+  case TYPE::LINE:
+    return Create<Graphics::Line>(SDL_Point{int(p[0]), int(p[1])}, SDL_Point{int(p[2]), int(p[3])}, p[4], UnpackColor(r.color), parent, name);
+  case TYPE::SPRITE:
+    return Create<Graphics::Sprite>(std::string(strings + r.path), parent, name);
+  case TYPE::RIGIDBODY:
+  {
+    Physics::Rigidbody *rb = Create<Physics::Rigidbody>(double(p[0]), parent, name);
+    rb->SetGravityScale(p[1]);
+    return rb;
+  }
+  case TYPE::CIRCLE_COLLIDER:
+  {
+    Physics::CircleCollider *c = Create<Physics::CircleCollider>(double(p[0]), parent, name);
+    c->SetTrigger((r.flags & RECORD_FLAGS::TRIGGER) != 0);
+    return c;
+  }
+  case TYPE::AABB_COLLIDER:
+  {
+    Physics::AABBCollider *c = Create<Physics::AABBCollider>(double(p[0]), double(p[1]), parent, name);
+    c->SetTrigger((r.flags & RECORD_FLAGS::TRIGGER) != 0);
+    return c;
+  }
+  default:
+    return Create<Object::Object>(parent, name);
+  }
+}
+
+bool Load(std::string path, Object::Object *parent)
+{
+  if (!parent)
+    return false;
+  MappedFile file(path);
+  if (!file.data)
+  {
+    Log::Error("Couldn't open scene %s", path.c_str());
+    return false;
+  }
+  const Header *header = reinterpret_cast<const Header *>(file.data);
+  if (file.size < sizeof(Header) || std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0)
+  {
+    Log::Error("%s isn't a scene file", path.c_str());
+    return false;
+  }
+  if (header->version != VERSION)
+  {
+    Log::Error("%s was saved with scene format version %u, but only version %u can be loaded", path.c_str(), unsigned(header->version), unsigned(VERSION));
+    return false;
+  }
+  std::uint32_t count = header->objectCount;
+  // Checked before multiplying so the size can't overflow
+  if (count > (file.size - sizeof(Header)) / sizeof(Record))
+  {
+    Log::Error("Scene %s is truncated or corrupt", path.c_str());
+    return false;
+  }
+  std::size_t recordBytes = std::size_t(count) * sizeof(Record);
+  if (file.size - sizeof(Header) - recordBytes != header->stringBytes || header->stringBytes == 0 ||
+      file.data[file.size - 1] != '\0')
+  {
+    Log::Error("Scene %s is truncated or corrupt", path.c_str());
+    return false;
+  }
+  const Record *records = reinterpret_cast<const Record *>(file.data + sizeof(Header));
+  const char *strings = file.data + sizeof(Header) + recordBytes;
+
+  // Every record is checked and its parent's children counted before anything is created,
+  // so a bad file doesn't leave half a scene behind and each list of children is only allocated once
+  std::vector<unsigned> childCounts(count, 0);
+  unsigned topLevel = 0;
+  for (std::uint32_t i = 0; i < count; ++i)
+  {
+    const Record &r = records[i];
+    if (r.type >= TYPE::COUNT || r.name >= header->stringBytes || r.path >= header->stringBytes ||
+        (r.parent != ROOT && r.parent >= i) || !ValidValues(r))
+    {
+      Log::Error("Scene %s has a corrupt record at %u", path.c_str(), unsigned(i));
+      return false;
+    }
+    if (r.parent == ROOT)
+      ++topLevel;
+    else
+      ++childCounts[r.parent];
+  }
+
+  // Top level Objects are only added to parent once every Object was created,
+  // so one that can't be (like a Sprite whose image is missing) fails the whole load
+  std::vector<Object::Object *> objects(count, nullptr);
+  std::vector<Object::Object *> roots;
+  roots.reserve(topLevel);
+  for (std::uint32_t i = 0; i < count; ++i)
+  {
+    const Record &r = records[i];
+    Object::Object *p = r.parent == ROOT ? parent : objects[r.parent];
+    Object::Object *o = CreateObject(r, p, strings);
+    if (!o->Valid())
+    {
+      Log::Error("Scene %s has a record at %u that couldn't be created (%s)", path.c_str(), unsigned(i), o->Name().c_str());
+      delete o;
+      for (Object::Object *root : roots)
+        delete root;
+      return false;
+    }
+    if (r.flags & RECORD_FLAGS::TRANSFORM)
+    {
+      Transform::Transform *tf = o->CreateTransform();
+      tf->SetPosition(r.x, r.y);
+      tf->SetRotation(r.rotation);
+      tf->SetScale(r.xScale, r.yScale);
+    }
+    o->Children().reserve(childCounts[i]);
+    if (r.parent == ROOT)
+      roots.push_back(o);
+    else
+      p->AddChild(o);
+    objects[i] = o;
+  }
+  parent->Children().reserve(parent->ChildrenCount() + topLevel);
+  for (Object::Object *root : roots)
+    parent->AddChild(root);
+  Log::Info("Loaded %u Objects from %s", unsigned(count), path.c_str());
+  return true;
+}
+} // namespace Scene
+} // namespace Aspen
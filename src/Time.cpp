@@ -1,6 +1,7 @@
 #define __TIME_CPP
 
 #include "Time.hpp"
+#include "Engine.hpp"
 #ifdef __LINUX
 #include <thread>
 #endif
@@ -50,7 +51,8 @@ void Time::operator()()
   _lastTime = _currentTime;
   _currentTime = GetTime();
   _deltaTime = _currentTime - _lastTime;
-  if (FPS() > double(_targetFramerate))
+  Engine::Engine *engine = Engine::Engine::Get();
+  if (FPS() > double(_targetFramerate) && !(engine && engine->Headless()))
   {
     Sleep((1.0 / double(_targetFramerate)) - DeltaTime());
     _currentTime = GetTime();
@@ -4,6 +4,7 @@
 #include "Engine.hpp"
 #include "Graphics.hpp"
 #include <cmath>
+#include <algorithm>
 #include "imgui.h"
 
 #undef __TRANSFORM_CPP
@@ -12,177 +13,183 @@ namespace Aspen
 {
 namespace Transform
 {
-Transform::Transform(Object *parent, std::string name)
-    : Object(parent, name), _posx(0), _posy(0), _r(0), _scalex(1), _scaley(1)
+double Transform::_interpolation = 1.0;
+double Transform::_drawInterpolation = 1.0;
+
+Transform::Transform(Object::Object *owner)
+    : _owner(owner), _posx(0), _posy(0), _r(0), _scalex(1), _scaley(1), _registryEntry(this), _world(), _dirty(true), _hasPrevious(false), _previous()
 {
+  if (_owner && !_owner->_transform)
+  {
+    _owner->_transform = this;
+    InvalidateDescendants(_owner);
+  }
+  else
+    _owner = nullptr;
+}
+
+Transform::Transform(const Transform &other)
+    : _owner(nullptr), _posx(other._posx), _posy(other._posy), _r(other._r), _scalex(other._scalex), _scaley(other._scaley),
+      _registryEntry(this), _world(), _dirty(true), _hasPrevious(false), _previous()
+{
+}
+
+Transform &Transform::operator=(const Transform &other)
+{
+  _posx = other._posx;
+  _posy = other._posy;
+  _r = other._r;
+  _scalex = other._scalex;
+  _scaley = other._scaley;
+  Invalidate();
+  return *this;
+}
+
+Transform::~Transform()
+{
+  if (_owner && _owner->_transform == this)
+  {
+    _owner->_transform = nullptr;
+    InvalidateDescendants(_owner);
+  }
+}
+
+Object::Object *Transform::Owner() const
+{
+  return _owner;
+}
+
+bool Transform::Valid() const
+{
+  return !_owner || _owner->Valid();
 }
 
 void Transform::SetPosition(float x, float y)
 {
   _posx = x;
   _posy = y;
+  Invalidate();
 }
 
 void Transform::SetXPosition(float x)
 {
   _posx = x;
+  Invalidate();
 }
 
 void Transform::SetYPosition(float y)
 {
   _posy = y;
+  Invalidate();
 }
 
 void Transform::SetRotation(double r)
 {
   _r = std::fmod(r, 360.0);
+  Invalidate();
 }
 
 void Transform::SetScale(float x, float y)
 {
   _scalex = x;
   _scaley = y;
+  Invalidate();
 }
 
 void Transform::SetXScale(float x)
 {
   _scalex = x;
+  Invalidate();
 }
 
 void Transform::SetYScale(float y)
 {
   _scaley = y;
+  Invalidate();
 }
 
 void Transform::ModifyPosition(float x, float y)
 {
   _posx += x;
   _posy += y;
+  Invalidate();
 }
 
 void Transform::ModifyXPosition(float x)
 {
   _posx += x;
+  Invalidate();
 }
 
 void Transform::ModifyYPosition(float y)
 {
   _posy += y;
+  Invalidate();
 }
 
 void Transform::ModifyRotation(double r)
 {
   _r = std::fmod(_r + r, 360.0);
+  Invalidate();
 }
 
 void Transform::ModifyScale(float x, float y)
 {
   _scalex *= x;
   _scaley *= y;
+  Invalidate();
 }
 
 void Transform::ModifyXScale(float x)
 {
   _scalex *= x;
+  Invalidate();
 }
 
 void Transform::ModifyYScale(float y)
 {
   _scaley *= y;
+  Invalidate();
 }
 
 float Transform::GetXPosition() const
 {
-  std::vector<const Transform *> tfs;
-  const Object *p = this;
-  tfs.push_back(this);
-  while (p)
-  {
-    const Transform *tf = dynamic_cast<const Transform *>(p);
-    if (!tf)
-      tf = p->GetTransform();
-    if (tf && tf != this)
-      tfs.push_back(tf);
-    p = p->Parent();
-  }
-  float ret = 0.0f;
-  for (const Transform *tf : tfs)
-  {
-    // TODO: Incorporate rotation
-    ret += tf->GetLocalXPosition() * tf->GetXScale() * tf->GetLocalInverseXScale();
-  }
-  return ret;
+  double x = World().xPosition;
+  if (_interpolation < 1.0 && _hasPrevious)
+    return float(Interpolate(_previous.xPosition, x));
+  return float(x);
 }
 
 float Transform::GetYPosition() const
 {
-  std::vector<const Transform *> tfs;
-  const Object *p = this;
-  tfs.push_back(this);
-  while (p)
-  {
-    const Transform *tf = dynamic_cast<const Transform *>(p);
-    if (!tf)
-      tf = p->GetTransform();
-    if (tf && tf != this)
-      tfs.push_back(tf);
-    p = p->Parent();
-  }
-  float ret = 0.0f;
-  for (const Transform *tf : tfs)
-  {
-    // TODO: Incorporate rotation
-    ret += tf->GetLocalYPosition() * tf->GetYScale() * tf->GetLocalInverseYScale();
-  }
-  return ret;
+  double y = World().yPosition;
+  if (_interpolation < 1.0 && _hasPrevious)
+    return float(Interpolate(_previous.yPosition, y));
+  return float(y);
 }
 
 double Transform::GetRotation() const
 {
-  const Object *p = this;
-  double ret = 0.0;
-  while (p)
-  {
-    const Transform *tf = dynamic_cast<const Transform *>(p);
-    if (!tf)
-      tf = p->GetTransform();
-    if (tf)
-      ret += tf->GetLocalRotation();
-    p = p->Parent();
-  }
-  return ret;
+  double r = World().rotation;
+  if (_interpolation < 1.0 && _hasPrevious)
+    return _previous.rotation + std::remainder(r - _previous.rotation, 360.0) * _interpolation;
+  return r;
 }
 
 float Transform::GetXScale() const
 {
-  const Object *p = this;
-  double ret = 1.0;
-  while (p)
-  {
-    const Transform *tf = dynamic_cast<const Transform *>(p);
-    if (!tf)
-      tf = p->GetTransform();
-    if (tf)
-      ret *= tf->GetLocalXScale();
-    p = p->Parent();
-  }
-  return ret;
+  double s = World().xScale;
+  if (_interpolation < 1.0 && _hasPrevious)
+    return float(Interpolate(_previous.xScale, s));
+  return float(s);
 }
 
 float Transform::GetYScale() const
 {
-  const Object *p = this;
-  double ret = 1.0;
-  while (p)
-  {
-    const Transform *tf = dynamic_cast<const Transform *>(p);
-    if (!tf)
-      tf = p->GetTransform();
-    if (tf)
-      ret *= tf->GetLocalYScale();
-    p = p->Parent();
-  }
-  return ret;
+  double s = World().yScale;
+  if (_interpolation < 1.0 && _hasPrevious)
+    return float(Interpolate(_previous.yScale, s));
+  return float(s);
 }
 
 float Transform::GetXPosition(const Transform *camera) const
@@ -337,16 +344,175 @@ Transform &Transform::operator+=(const Transform &rhs)
   return *this;
 }
 
+void Transform::SaveState()
+{
+  double alpha = _interpolation;
+  _interpolation = 1.0;
+  _previous.xPosition = GetXPosition();
+  _previous.yPosition = GetYPosition();
+  _previous.rotation = GetRotation();
+  _previous.xScale = GetXScale();
+  _previous.yScale = GetYScale();
+  _hasPrevious = true;
+  _interpolation = alpha;
+}
+
+void Transform::SetInterpolation(double alpha)
+{
+  _interpolation = std::min(std::max(alpha, 0.0), 1.0);
+}
+
+double Transform::GetInterpolation()
+{
+  return _interpolation;
+}
+
+void Transform::SetDrawInterpolation(double alpha)
+{
+  _drawInterpolation = std::min(std::max(alpha, 0.0), 1.0);
+}
+
+double Transform::GetDrawInterpolation()
+{
+  return _drawInterpolation;
+}
+
+Transform::DrawScope::DrawScope()
+    : _previous(_interpolation)
+{
+  _interpolation = _drawInterpolation;
+}
+
+Transform::DrawScope::~DrawScope()
+{
+  _interpolation = _previous;
+}
+
+double Transform::Interpolate(double previous, double current)
+{
+  return previous + (current - previous) * _interpolation;
+}
+
+void Transform::Invalidate()
+{
+  if (_owner)
+    _owner->Wake();
+  // Anything depending on this was recalculated through this, so a dirty cache means they're all dirty too
+  if (_dirty)
+  {
+    // Nothing may have read the cache since it was marked, so the children moving with the owner are woken here
+    if (_owner)
+      for (Object::Object *child : _owner->Children())
+        child->Wake();
+    return;
+  }
+  _dirty = true;
+  if (_owner)
+    InvalidateDescendants(_owner);
+}
+
+void Transform::InvalidateDescendants(Object::Object *root)
+{
+  for (Object::Object *child : root->Children())
+  {
+    // Sleeping Objects are always clean (see Object::Sleep), so any that moved are reached here
+    child->Wake();
+    Transform *tf = child->GetTransform();
+    if (tf)
+    {
+      if (tf->_dirty)
+        continue;
+      tf->_dirty = true;
+    }
+    InvalidateDescendants(child);
+  }
+}
+
+void Transform::InvalidateTree(Object::Object *root)
+{
+  // root moved with its new parent even if it has no Transform of its own
+  root->Wake();
+  Transform *tf = root->GetTransform();
+  if (tf)
+  {
+    if (tf->_dirty)
+      return;
+    tf->_dirty = true;
+  }
+  InvalidateDescendants(root);
+}
+
+void Transform::UpdateCache(const Object::Object *o)
+{
+  Accumulate(o);
+}
+
+void Transform::UpdateTreeCache(Object::Object *root)
+{
+  Accumulate(root);
+  // Parents are reached first, so each dirty cache is filled from a clean one above it
+  std::vector<Object::Object *> stack(1, root);
+  while (!stack.empty())
+  {
+    Object::Object *o = stack.back();
+    stack.pop_back();
+    for (Object::Object *child : o->Children())
+    {
+      const Transform *tf = child->GetTransform();
+      if (tf)
+        tf->World();
+      stack.push_back(child);
+    }
+  }
+}
+
+const Transform::Accumulated &Transform::World() const
+{
+  if (_dirty)
+  {
+    Accumulated a = Accumulate(_owner ? _owner->Parent() : nullptr);
+    _world.xPosition = a.xPosition + _posx * a.xScale;
+    _world.yPosition = a.yPosition + _posy * a.yScale;
+    _world.rotation = a.rotation + _r;
+    _world.xScale = a.xScale * _scalex;
+    _world.yScale = a.yScale * _scaley;
+    _dirty = false;
+  }
+  return _world;
+}
+
+Transform::Accumulated Transform::Accumulate(const Object::Object *o)
+{
+  while (o)
+  {
+    const Transform *tf = o->GetTransform();
+    if (tf)
+      return tf->World();
+    o = o->Parent();
+  }
+  Accumulated root;
+  root.xPosition = 0.0;
+  root.yPosition = 0.0;
+  root.rotation = 0.0;
+  root.xScale = 1.0;
+  root.yScale = 1.0;
+  return root;
+}
+
 void Transform::PopulateDebugger()
 {
-  ImGui::DragFloat2("Pos", &_posx, 1.0f);
+  if (ImGui::DragFloat2("Pos", &_posx, 1.0f))
+    Invalidate();
   static float r = 0;
   r = float(_r);
   ImGui::DragFloat("Rotation", &r, M_PI / 180.0f);
   if (std::abs(r - _r) >= M_PI / 180.0f)
+  {
     _r = r;
-  ImGui::DragFloat2("Scale", &_scalex, 0.01f);
-  Object::PopulateDebugger();
+    Invalidate();
+  }
+  if (ImGui::DragFloat2("Scale", &_scalex, 0.01f))
+    Invalidate();
 }
 } // namespace Transform
 } // namespace Aspen
@@ -28,12 +28,25 @@ Text::Text(std::string text, std::string font, int size, Object *parent, std::st
 }
 
 Text::Text(std::string text, std::string font, int size, Color c, Object *parent, std::string name)
-    : Object(parent, name), _text(text), _font(font), _tex(nullptr), _c(c), _rect({0, 0, 0, 0}), _size(size)
+    : Object(parent, name), _text(text), _font(font), _tex(nullptr), _c(c), _rect({0, 0, 0, 0}), _size(size), _transformComponent(this)
 {
-  CreateChild<Aspen::Transform::Transform>();
+  _draws = true;
   GenerateTexture();
 }
 
+Text::Text(const Text &other, Object *parent)
+    : Object(other, parent), _text(other._text), _font(other._font), _tex(nullptr), _c(other._c), _rect(other._rect), _size(other._size), _transformComponent(this)
+{
+  _transformComponent = other._transformComponent;
+  // The rendered texture belongs to other, but the font it's rendered with is shared through the FontCache
+  GenerateTexture();
+}
+
+Object::Object *Text::Clone(Object *parent) const
+{
+  return new Text(*this, parent);
+}
+
 Text::~Text()
 {
   if (_tex)
@@ -55,7 +68,7 @@ void Text::operator()()
       Graphics *gfx = Graphics::Get();
       if (gfx)
         gfx->DrawText(this);
-      else
+      else if (!engine->Headless())
         Log::Error("%s requires an ancestor Engine with child Graphics!", Name().c_str());
     }
     else
@@ -116,6 +129,11 @@ void Text::SetSize(int size)
 
 void Text::GenerateTexture()
 {
+  if (InParallelUpdate())
+  {
+    Defer([this]() { GenerateTexture(); });
+    return;
+  }
   if (_tex)
   {
     SDL_DestroyTexture(_tex);
@@ -160,7 +178,7 @@ void Text::GenerateTexture()
       else
         Log::Error("%s can't find FontCache in Graphics!", Name().c_str());
     }
-    else
+    else if (!engine->Headless())
       Log::Error("%s requires an ancestor Engine with child Graphics!", Name().c_str());
   }
   else
@@ -189,39 +207,46 @@ Button::Button(std::string text, Object *parent, std::string name)
     : Button("Button", 16, parent, name) {}
 
 Button::Button(std::string text, int size, Object *parent, std::string name)
-    : Object(parent, name)
-{
-  CreateChild<Transform::Transform>();
-  _rectangle = CreateChild<Rectangle>();
-  _rectangle->SetFill(true);
-  _rectangle->GetTransform()->SetScale(0.3f, 0.3f);
-  _textObj = CreateChild<Text>();
-  _textObj->SetFont("default");
-  _textObj->SetSize(size * 20);
-  _textObj->GetTransform()->SetScale(0.3f, 0.3f);
-  _collider = CreateChild<Physics::AABBCollider>();
-  _collider->SetTrigger(true);
-  _collider->GetTransform()->SetScale(0.3f, 0.3f);
+    : Object(parent, name), _transformComponent(this)
+{
+  Rectangle *rectangle = CreateChild<Rectangle>();
+  rectangle->SetFill(true);
+  rectangle->GetTransform()->SetScale(0.3f, 0.3f);
+  rectangle->Color(0xAAAAAAFF);
+  _rectangle = rectangle;
+  Text *textObj = CreateChild<Text>();
+  textObj->SetFont("default");
+  textObj->SetSize(size * 20);
+  textObj->GetTransform()->SetScale(0.3f, 0.3f);
+  _textObj = textObj;
+  Physics::AABBCollider *collider = CreateChild<Physics::AABBCollider>();
+  collider->SetTrigger(true);
+  collider->GetTransform()->SetScale(0.3f, 0.3f);
+  _collider = collider;
   SetText(text);
-  _rectangle->Color(0xAAAAAAFF);
 }
 
 void Button::SetText(std::string text, int size)
 {
-  _textObj->SetSize(size * 20);
+  if (_textObj)
+    _textObj->SetSize(size * 20);
   SetText(text);
 }
 
 void Button::SetText(std::string text, std::string font)
 {
-  _textObj->SetFont(font);
+  if (_textObj)
+    _textObj->SetFont(font);
   SetText(text);
 }
 
 void Button::SetText(std::string text, int size, std::string font)
 {
-  _textObj->SetSize(size * 20);
-  _textObj->SetFont(font);
+  if (_textObj)
+  {
+    _textObj->SetSize(size * 20);
+    _textObj->SetFont(font);
+  }
   SetText(text);
 }
 
@@ -230,11 +255,16 @@ void Button::SetText(std::string text)
   if (_text == text)
     return;
   _text = text;
-  _textObj->SetText(_text);
-  _rectangle->GetRect().w = _textObj->GetRect().w + 40;
-  _rectangle->GetRect().h = _textObj->GetRect().h + 20;
-  _collider->SetSize(_rectangle->GetRect().w * _rectangle->GetTransform()->GetLocalXScale(),
-                     _rectangle->GetRect().h * _rectangle->GetTransform()->GetLocalYScale());
+  Text *textObj = _textObj.Get();
+  Rectangle *rectangle = _rectangle.Get();
+  if (!textObj || !rectangle)
+    return;
+  textObj->SetText(_text);
+  rectangle->GetRect().w = textObj->GetRect().w + 40;
+  rectangle->GetRect().h = textObj->GetRect().h + 20;
+  if (_collider)
+    _collider->SetSize(rectangle->GetRect().w * rectangle->GetTransform()->GetLocalXScale(),
+                       rectangle->GetRect().h * rectangle->GetTransform()->GetLocalYScale());
 }
 
 void Button::SetOnClick(ButtonCallback cb)
@@ -244,12 +274,14 @@ void Button::SetOnClick(ButtonCallback cb)
 
 void Button::OnMouseEnter()
 {
-  _rectangle->Color(0x777777FF);
+  if (_rectangle)
+    _rectangle->Color(0x777777FF);
 }
 
 void Button::OnMouseExit()
 {
-  _rectangle->Color(0xAAAAAAFF);
+  if (_rectangle)
+    _rectangle->Color(0xAAAAAAFF);
 }
 
 void Button::OnMouseClick()
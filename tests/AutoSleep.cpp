@@ -0,0 +1,85 @@
+#include "Engine.hpp"
+#include "GameState.hpp"
+#include "Physics.hpp"
+#include "Transform.hpp"
+#include <cstdio>
+
+/// \brief Number of frames each case runs for
+///        Longer than the longest sleep delay, so anything idle has fallen asleep by the end
+const int FRAMES = 2 * Aspen::Object::Object::MAX_SLEEP_DELAY;
+
+/// \brief Object that moves its parent every update
+class ParentMover : public Aspen::Object::Object
+{
+public:
+  /// \brief Constructor
+  /// \param parent Parent Object to be passed to Object constructor
+  /// \param name Object name
+  ParentMover(Aspen::Object::Object *parent = nullptr, std::string name = "ParentMover")
+      : Aspen::Object::Object(parent, name)
+  {
+  }
+
+  /// \brief Moves the parent without reading any world values
+  void OnUpdate()
+  {
+    Parent()->GetTransform()->ModifyXPosition(1);
+  }
+};
+
+/// \brief Reports a failed check
+/// \param ok Result of the check
+/// \param what Description of the check
+/// \return ok
+static bool Check(bool ok, const char *what)
+{
+  std::printf("%s: %s\n", ok ? "pass" : "FAIL", what);
+  return ok;
+}
+
+/// \brief Checks that AutoSleep only puts idle Objects to sleep when nothing reads the world values they change
+///        Usage: autosleep
+///        Run with `make test`
+///        Exits with 1 if any check fails
+int main(int argc, char **argv)
+{
+  Aspen::Log::Info.TogglePrint();
+  Aspen::Engine::Engine engine(Aspen::Engine::START_FLAGS::HEADLESS |
+                               Aspen::Engine::START_FLAGS::CREATE_PHYSICS |
+                               Aspen::Engine::START_FLAGS::CREATE_GAMESTATEMANAGER);
+  engine.FindChildOfType<Aspen::Physics::Physics>()->SetGravityStrength(0);
+  Aspen::Object::Object *root = engine.FindChildOfType<Aspen::GameState::GameStateManager>();
+
+  Aspen::Object::Object *moved = root->CreateChild<Aspen::Object::Object>();
+  moved->CreateTransform();
+  ParentMover *mover = moved->CreateChild<ParentMover>();
+  mover->AutoSleep(true);
+
+  Aspen::Object::Object *body = root->CreateChild<Aspen::Object::Object>();
+  body->CreateTransform();
+  Aspen::Physics::Rigidbody *moving = body->CreateChild<Aspen::Physics::Rigidbody>();
+  moving->AutoSleep(true);
+  moving->SetCartesianVelocity(1, 0);
+
+  Aspen::Object::Object *rest = root->CreateChild<Aspen::Object::Object>();
+  rest->CreateTransform();
+  Aspen::Physics::Rigidbody *resting = rest->CreateChild<Aspen::Physics::Rigidbody>();
+  resting->AutoSleep(true);
+
+  bool ok = true;
+  for (int i = 0; i < FRAMES; ++i)
+    engine();
+  ok &= Check(!mover->Sleeping() && moved->GetTransform()->GetLocalXPosition() == FRAMES,
+              "a child moving its parent stays awake");
+  ok &= Check(!moving->Sleeping() && body->GetTransform()->GetLocalXPosition() == FRAMES,
+              "a moving Rigidbody stays awake");
+  ok &= Check(resting->Sleeping(), "a resting Rigidbody falls asleep");
+
+  engine.FixedTimestep(1.0 / 60.0);
+  body->GetTransform()->SetXPosition(0);
+  for (int i = 0; i < FRAMES; ++i)
+    engine();
+  ok &= Check(!moving->Sleeping() && body->GetTransform()->GetLocalXPosition() == FRAMES,
+              "a moving Rigidbody stays awake with a fixed timestep");
+  return ok ? 0 : 1;
+}